@@ -0,0 +1,127 @@
+#include "../include/battleshipCpu.hpp"
+#include "../include/replay.hpp"
+#include "../include/objectPool.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+using namespace std;
+
+// Counts heap allocations made by the CPU while it plays (after the game is set up),
+// and compares setting up new games with reusing them from an ObjectPool.
+// Usage: allocBench [numGames]
+
+static long long numAllocations = 0;
+
+void* operator new(size_t size) {
+    numAllocations++;
+    void* memory = malloc(size ? size : 1);
+    if (!memory) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+    free(memory);
+}
+
+// Sets up games, either new ones or from the pool, and reports the allocations and time per setup.
+// Pooled games should need no allocations once the pool has its first game.
+static bool benchSetup(int numGames, bool isPooled) {
+    ObjectPool<BattleshipCPU> pool;
+    pool.release(pool.acquire());
+
+    long long before = numAllocations;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < numGames; i++) {
+        BattleshipCPU* game = isPooled ? pool.acquire() : new BattleshipCPU();
+        Replay::setUpGame(*game, 1000 + i, APPROXIMATE_DENSITY, "");
+        if (isPooled) {
+            pool.release(game);
+        } else {
+            delete game;
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    long long allocations = numAllocations - before;
+
+    cout << (isPooled ? "Pooled" : "New") << " games: " << double(allocations) / numGames
+         << " allocations and " << (seconds * 1e9) / numGames << " ns per setup" << endl;
+    return !isPooled || allocations == 0;
+}
+
+int main(int argc, char* argv[]) {
+    int numGames = (argc > 1) ? stoi(argv[1]) : 1000;
+    const DensityEngine engines[] = {APPROXIMATE_DENSITY, EXACT_DENSITY, MONTE_CARLO_DENSITY,
+                                     RANDOM_TARGETING, CHECKERBOARD_TARGETING};
+    bool isAllocationFree = true;
+
+    isAllocationFree = benchSetup(numGames * 10, false) && isAllocationFree;
+    isAllocationFree = benchSetup(numGames * 10, true) && isAllocationFree;
+
+    for (DensityEngine engine : engines) {
+        // Sampling is much slower, so it plays fewer games.
+        int currGames = (engine == MONTE_CARLO_DENSITY) ? (numGames / 20) + 1 : numGames;
+        long long setupAllocations = 0;
+        long long turnAllocations = 0;
+        long long turns = 0;
+        double seconds = 0;
+
+        for (int i = 0; i < currGames; i++) {
+            long long before = numAllocations;
+            BattleshipCPU game;
+            Replay::setUpGame(game, 1000 + i, engine, "");
+            setupAllocations += numAllocations - before;
+
+            before = numAllocations;
+            auto start = chrono::steady_clock::now();
+            while (!game.isP2Win() && game.getBoard(1).getNumShots() < 100) {
+                game.cpuShoot();
+                turns++;
+            }
+            seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            turnAllocations += numAllocations - before;
+        }
+
+        cout << BattleshipCPU::getEngineName(engine) << ": " << currGames << " games, "
+             << double(setupAllocations) / currGames << " allocations per setup, "
+             << turnAllocations << " allocations in " << turns << " turns ("
+             << (seconds * 1e6) / turns << " us per turn)" << endl;
+        isAllocationFree = isAllocationFree && turnAllocations == 0;
+    }
+
+    // The endgame allocates when it's turned on, never during a move.
+    BattleshipCPU game;
+    long long turnAllocations = 0;
+    for (int i = 0; i < numGames; i++) {
+        Replay::setUpGame(game, 1000 + i, APPROXIMATE_DENSITY, "");
+        game.setEndgameThreshold(10);
+        long long before = numAllocations;
+        while (!game.isP2Win() && game.getBoard(1).getNumShots() < 100) {
+            game.cpuShoot();
+        }
+        turnAllocations += numAllocations - before;
+    }
+    cout << "endgame on: " << numGames << " games, " << turnAllocations << " allocations while playing" << endl;
+    isAllocationFree = isAllocationFree && turnAllocations == 0;
+
+    cout << (isAllocationFree ? "PASS" : "FAIL") << ": no allocations while playing or setting up pooled games" << endl;
+    return isAllocationFree ? 0 : 1;
+}
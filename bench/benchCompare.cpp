@@ -0,0 +1,97 @@
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+using namespace std;
+
+// Compares benchSuite results with a baseline, and fails if anything got worse.
+// Usage: benchCompare baselineFile resultsFile [tolerance]
+// A "time" result is a regression if it's more than tolerance (0.25 by default) slower than the
+// baseline. An "exact" result (such as the shots on fixed seeds) has to match.
+
+struct BenchResult {
+    double value;
+    string unit;
+    string kind;
+};
+
+// Reads a string or number field of a result line (the lines benchSuite writes, not any JSON).
+static string getField(const string &line, const string &name) {
+    string key = "\"" + name + "\":";
+    size_t start = line.find(key);
+    if (start == string::npos) {
+        return "";
+    }
+    start += key.length();
+    if (line[start] == '"') {
+        return line.substr(start + 1, line.find('"', start + 1) - start - 1);
+    }
+    return line.substr(start, line.find_first_of(",}", start) - start);
+}
+
+static bool readResults(const string &fileName, map<string, BenchResult> &results) {
+    ifstream resultsFile(fileName);
+    if (!resultsFile.is_open()) {
+        cout << "Error: The results file '" << fileName << "' cannot be found." << endl;
+        return false;
+    }
+    string line;
+    while (getline(resultsFile, line)) {
+        string name = getField(line, "name");
+        if (!name.empty()) {
+            results[name] = {stod(getField(line, "value")), getField(line, "unit"), getField(line, "kind")};
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout << "Usage: benchCompare baselineFile resultsFile [tolerance]" << endl;
+        return 1;
+    }
+    double tolerance = (argc > 3) ? stod(argv[3]) : 0.25;
+    map<string, BenchResult> baseline;
+    map<string, BenchResult> results;
+    if (!readResults(argv[1], baseline) || !readResults(argv[2], results)) {
+        return 1;
+    }
+
+    int numRegressions = 0;
+    cout << fixed << setprecision(2);
+    cout << left << setw(40) << "Benchmark" << right << setw(14) << "Baseline" << setw(14) << "Current"
+         << setw(10) << "Change" << endl;
+    for (const auto &entry : results) {
+        const string &name = entry.first;
+        const BenchResult &current = entry.second;
+        cout << left << setw(40) << name << right;
+        auto base = baseline.find(name);
+        if (base == baseline.end()) {
+            cout << setw(14) << "-" << setw(14) << current.value << setw(10) << "new" << endl;
+            continue;
+        }
+
+        double change = (base->second.value != 0) ? (current.value - base->second.value) / base->second.value : 0;
+        bool isRegression;
+        if (current.kind == "exact") {
+            isRegression = fabs(current.value - base->second.value) > 1e-9;
+        } else {
+            isRegression = change > tolerance;
+        }
+        numRegressions += isRegression;
+        cout << setw(14) << base->second.value << setw(14) << current.value << setw(9) << showpos
+             << change * 100 << noshowpos << '%' << (isRegression ? "  REGRESSION" : "") << "  " << current.unit << endl;
+    }
+    for (const auto &entry : baseline) {
+        if (!results.count(entry.first)) {
+            cout << left << setw(40) << entry.first << right << setw(14) << entry.second.value
+                 << setw(14) << "-" << setw(10) << "missing" << endl;
+        }
+    }
+
+    cout << (numRegressions == 0 ? "PASS" : "FAIL") << ": " << numRegressions << " regressions (time tolerance "
+         << tolerance * 100 << "%)" << endl;
+    return (numRegressions == 0) ? 0 : 1;
+}
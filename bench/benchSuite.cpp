@@ -0,0 +1,265 @@
+#include "../include/battleshipCpu.hpp"
+#include "../include/boardCorpus.hpp"
+#include "../include/exactDensity.hpp"
+#include "../include/exactStrategy.hpp"
+#include "../include/replay.hpp"
+#include <chrono>
+#include <fcntl.h>
+#include <functional>
+#include <iostream>
+#include <unistd.h>
+using namespace std;
+
+// Micro and macro benchmarks, one JSON result per line, to compare against a stored baseline
+// with benchCompare. Run it from a folder next to boards (like the game), e.g. through make bench-run.
+// Usage: benchSuite [scale]
+// Results have a kind: "time" (noisy, compared with a tolerance) or "exact" (must match, such as
+// the average shots on fixed seeds, which only change if the CPU plays differently).
+// Each time is the best of a few runs, since other work on the machine only ever adds to it.
+
+// Exposes the internals that are timed.
+class BenchGame : public BattleshipCPU {
+    public:
+        using BattleshipCPU::placeShips;
+        using BattleshipCPU::getShipsFromFile;
+        using BattleshipCPU::isShipPlacementValid;
+};
+class BenchHeuristic : public HeuristicStrategy {
+    public:
+        using HeuristicStrategy::calculateProbability;
+        using HeuristicStrategy::getNextMove;
+        // As after a shot, and after a ship sinks (the parity changes too).
+        void markShot() { densityOutdated = true; }
+        void markSunk() { densityOutdated = true; parityOutdated = true; }
+};
+class BenchExact : public ExactStrategy {
+    public:
+        using ExactStrategy::chooseDensityMove;
+};
+
+static void report(const string &name, double value, const string &unit, const string &kind) {
+    cout << "{\"name\":\"" << name << "\",\"value\":" << value << ",\"unit\":\"" << unit
+         << "\",\"kind\":\"" << kind << "\"}" << endl;
+}
+
+static double getNanoseconds(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+}
+
+// The lowest result of the runs.
+static double getBest(function<double()> run) {
+    const int numRuns = 5;
+    double best = run();
+    for (int i = 1; i < numRuns; i++) {
+        double result = run();
+        best = (result < best) ? result : best;
+    }
+    return best;
+}
+
+// Plays seeded games with the engine (an empty layout places the ships from the seed) and reports
+// the average shots to win and the time per game.
+static void benchGames(const string &name, DensityEngine engine, const vector<string> &layouts, long long numGames) {
+    BattleshipCPU game;
+    long long totalShots = 0;
+    double nanos = getBest([&] {
+        totalShots = 0;
+        double gameNanos = 0;
+        for (long long i = 0; i < numGames; i++) {
+            game.reset();
+            Replay::setUpGame(game, 1000 + i, engine, layouts[i % layouts.size()]);
+            auto start = chrono::steady_clock::now();
+            while (!game.isP2Win() && game.getBoard(1).getNumShots() < 100) {
+                game.cpuShoot();
+            }
+            gameNanos += getNanoseconds(start);
+            totalShots += game.getBoard(1).getNumShots();
+        }
+        return gameNanos;
+    });
+    string prefix = "macro/" + name + "/" + BattleshipCPU::getEngineName(engine);
+    report(prefix + "/shots", double(totalShots) / numGames, "shots", "exact");
+    report(prefix + "/game", nanos / numGames / 1e3, "us", "time");
+}
+
+int main(int argc, char* argv[]) {
+    long long scale = (argc > 1) ? stoll(argv[1]) : 1;
+    long long iterations = 20000 * scale;
+    long long checksum = 0;
+
+    // placeShips: a random fleet on an empty board.
+    BenchGame game;
+    game.setOutputLevel(QUIET_OUTPUT);
+    game.setSeed(1);
+    Board board;
+    report("micro/placeShips", getBest([&] {
+        auto start = chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; i++) {
+            board.clear();
+            game.placeShips(board);
+            checksum += board.getShipMask(0).lo & 1;
+        }
+        return getNanoseconds(start) / iterations;
+    }), "ns", "time");
+
+    // getShipsFromFile: reading and checking a board file.
+    long long files = iterations / 100;
+    report("micro/getShipsFromFile", getBest([&] {
+        auto start = chrono::steady_clock::now();
+        for (long long i = 0; i < files; i++) {
+            board.clear();
+            game.getShipsFromFile("P1 Board.txt", board);
+        }
+        return getNanoseconds(start) / files;
+    }), "ns", "time");
+
+    // isShipPlacementValid on the fleet just read.
+    report("micro/isShipPlacementValid", getBest([&] {
+        auto start = chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; i++) {
+            checksum += game.isShipPlacementValid(board);
+        }
+        return getNanoseconds(start) / iterations;
+    }), "ns", "time");
+
+    // shoot: both players shoot every position of a two player game.
+    report("micro/shoot", getBest([&] {
+        long long numShots = 0;
+        double nanos = 0;
+        for (long long i = 0; i < iterations / 200; i++) {
+            game.reset();
+            game.setOutputLevel(QUIET_OUTPUT);
+            game.startGame(2, false, false);
+            auto start = chrono::steady_clock::now();
+            for (int cell = 0; cell < 100; cell++) {
+                game.shoot(char('A' + cell % 10), (cell / 10) + 1);
+                game.shoot(char('A' + cell % 10), (cell / 10) + 1);
+            }
+            nanos += getNanoseconds(start);
+            numShots += 200;
+        }
+        return nanos / numShots;
+    }), "ns", "time");
+
+    // calculateProbability and getNextMove, a third of the way through a game.
+    BattleshipCPU midGame;
+    Replay::setUpGame(midGame, 7, APPROXIMATE_DENSITY, "");
+    for (int i = 0; i < 30 && !midGame.isP2Win(); i++) {
+        midGame.cpuShoot();
+    }
+    BenchHeuristic heuristic;
+    heuristic.reset(midGame.getBoard(1));
+    report("micro/calculateProbability", getBest([&] {
+        auto start = chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; i++) {
+            heuristic.calculateProbability();
+        }
+        return getNanoseconds(start) / iterations;
+    }), "ns", "time");
+
+    // A hunt move after a shot: the density is recalculated and its best position found.
+    report("micro/getNextMove", getBest([&] {
+        auto start = chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; i++) {
+            heuristic.markShot();
+            checksum += heuristic.getNextMove().getX();
+        }
+        return getNanoseconds(start) / iterations;
+    }), "ns", "time");
+
+    // Hunt move selection: a full rebuild (density and parity) after a ship sinks, and the best
+    // position of a density recounted every turn (the exact and sampling engines).
+    report("micro/huntMove/rebuild", getBest([&] {
+        auto start = chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; i++) {
+            heuristic.markSunk();
+            checksum += heuristic.getNextMove().getX();
+        }
+        return getNanoseconds(start) / iterations;
+    }), "ns", "time");
+
+    BenchExact exact;
+    exact.reset(midGame.getBoard(1));
+    int exactDensity[100];
+    ExactDensity::calculate(midGame.getBoard(1).getTargetView(), exactDensity);
+    report("micro/huntMove/chooseDensityMove", getBest([&] {
+        auto start = chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; i++) {
+            checksum += exact.chooseDensityMove(exactDensity).getX();
+        }
+        return getNanoseconds(start) / iterations;
+    }), "ns", "time");
+
+    // cpuShoot: every turn of seeded games.
+    BattleshipCPU cpuGame;
+    report("micro/cpuShoot", getBest([&] {
+        long long numShots = 0;
+        double nanos = 0;
+        for (long long i = 0; numShots < iterations / 5; i++) {
+            cpuGame.reset();
+            Replay::setUpGame(cpuGame, i, APPROXIMATE_DENSITY, "");
+            auto start = chrono::steady_clock::now();
+            while (!cpuGame.isP2Win()) {
+                cpuGame.cpuShoot();
+                numShots++;
+            }
+            nanos += getNanoseconds(start);
+        }
+        return nanos / numShots;
+    }), "ns", "time");
+
+    // showBoard: full frames when piped, and changed positions only on an ANSI terminal.
+    // The frames (and the renderer's last escape codes) go to /dev/null instead of the results.
+    cout.flush();
+    int savedStdout = dup(STDOUT_FILENO);
+    int devNull = open("/dev/null", O_WRONLY);
+    dup2(devNull, STDOUT_FILENO);
+    long long frames = iterations / 10;
+    double frameNanos[2];
+    {
+        BattleshipCPU renderGame;
+        Replay::setUpGame(renderGame, 7, APPROXIMATE_DENSITY, "");
+        renderGame.setOutputLevel(FULL_OUTPUT);
+        for (int isAnsi = 0; isAnsi <= 1; isAnsi++) {
+            renderGame.getRenderer().setAnsi(isAnsi);
+            frameNanos[isAnsi] = getBest([&] {
+                auto start = chrono::steady_clock::now();
+                for (long long i = 0; i < frames; i++) {
+                    // A shot between frames, so there's something to redraw.
+                    if (!renderGame.isP2Win()) {
+                        renderGame.cpuShoot();
+                    }
+                    renderGame.showBoard();
+                }
+                return getNanoseconds(start) / frames;
+            });
+        }
+    }
+    dup2(savedStdout, STDOUT_FILENO);
+    close(devNull);
+    close(savedStdout);
+    report("micro/showBoard/full", frameNanos[0], "ns", "time");
+    report("micro/showBoard/ansi", frameNanos[1], "ns", "time");
+
+    // Whole games on fixed seeds (random fleets) and on the test boards.
+    const DensityEngine engines[] = {APPROXIMATE_DENSITY, EXACT_DENSITY, MONTE_CARLO_DENSITY,
+                                     RANDOM_TARGETING, CHECKERBOARD_TARGETING};
+    vector<string> randomFleets = {""};
+    BoardCorpus testBoards(1);
+    testBoards.loadDirectory("../boards/test boards");
+    vector<string> testLayouts;
+    for (int i = 0; i < testBoards.size(); i++) {
+        testLayouts.push_back(testBoards.getLayout(i));
+    }
+    for (DensityEngine engine : engines) {
+        // Sampling is much slower, so it plays fewer games.
+        long long numGames = (engine == MONTE_CARLO_DENSITY) ? 10 * scale : 500 * scale;
+        benchGames("seeded", engine, randomFleets, numGames);
+        if (!testLayouts.empty()) {
+            benchGames("testBoards", engine, testLayouts, numGames);
+        }
+    }
+
+    cerr << "(checksum " << checksum << ")" << endl;
+    return 0;
+}
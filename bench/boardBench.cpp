@@ -0,0 +1,125 @@
+#include "../include/battleshipCpu.hpp"
+#include "../include/exactDensity.hpp"
+#include "../include/exactStrategy.hpp"
+#include <chrono>
+#include <iostream>
+using namespace std;
+
+// Micro benchmarks for the board representation.
+// Usage: boardBench [iterations]
+
+// Exposes the CPU internals that are timed.
+class BenchCPU : public BattleshipCPU {
+    public:
+        using BattleshipCPU::placeShips;
+        Board& getP1Board() { return p1Board; }
+};
+class BenchHeuristic : public HeuristicStrategy {
+    public:
+        using HeuristicStrategy::calculateProbability;
+        using HeuristicStrategy::getNextMove;
+        using HeuristicStrategy::chooseDensityMove;
+        const int* getDensity() { return &probBoard[0][0]; }
+};
+class BenchExact : public ExactStrategy {
+    public:
+        using ExactStrategy::chooseDensityMove;
+};
+
+// Prints the average time per call of a timed loop.
+static void report(string name, chrono::steady_clock::time_point start, long long calls) {
+    double nanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    cout << name << ": " << nanos / calls << " ns/call" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    long long iterations = (argc > 1) ? stoll(argv[1]) : 200000;
+    long long checksum = 0;
+
+    // Board with a typical number of shots, for the probability pass.
+    BenchCPU midGame;
+    midGame.setOutputLevel(QUIET_OUTPUT);
+    midGame.startSimulation("");
+    for (int i = 0; i < 25 && !midGame.isP2Win(); i++) {
+        midGame.cpuShoot();
+    }
+    BenchHeuristic heuristic;
+    heuristic.reset(midGame.getP1Board());
+    checksum += heuristic.getNextMove().getX();
+
+    auto start = chrono::steady_clock::now();
+    for (long long i = 0; i < iterations; i++) {
+        heuristic.calculateProbability();
+    }
+    report("calculateProbability", start, iterations);
+
+    start = chrono::steady_clock::now();
+    for (long long i = 0; i < iterations; i++) {
+        int density[100];
+        ExactDensity::calculate(midGame.getP1Board().getTargetView(), density);
+        checksum += density[i % 100];
+    }
+    report("ExactDensity::calculate", start, iterations);
+
+    start = chrono::steady_clock::now();
+    for (long long i = 0; i < iterations; i++) {
+        checksum += heuristic.getNextMove().getX();
+    }
+    report("getNextMove", start, iterations);
+
+    // Choosing a hunt move after a shot (the density is recalculated).
+    start = chrono::steady_clock::now();
+    for (long long i = 0; i < iterations; i++) {
+        heuristic.calculateProbability();
+        checksum += heuristic.chooseDensityMove(heuristic.getDensity()).getX();
+    }
+    report("hunt move, full rescan", start, iterations);
+
+    // Choosing the best position of a density recounted every turn (the exact and sampling engines).
+    BenchExact exact;
+    exact.reset(midGame.getP1Board());
+    int exactDensity[100];
+    ExactDensity::calculate(midGame.getP1Board().getTargetView(), exactDensity);
+    start = chrono::steady_clock::now();
+    for (long long i = 0; i < iterations; i++) {
+        checksum += exact.chooseDensityMove(exactDensity).getX();
+    }
+    report("chooseDensityMove", start, iterations);
+
+    // Placing a random fleet on an empty board.
+    long long fleets = iterations / 10;
+    Board emptyBoard;
+    start = chrono::steady_clock::now();
+    for (long long i = 0; i < fleets; i++) {
+        emptyBoard.clear();
+        midGame.placeShips(emptyBoard);
+        checksum += emptyBoard.getShipMask(0).lo & 1;
+    }
+    report("placeShips", start, fleets);
+
+    // Setting up a game and placing the ships.
+    long long games = iterations / 100;
+    start = chrono::steady_clock::now();
+    for (long long i = 0; i < games; i++) {
+        BenchCPU game;
+        game.setOutputLevel(QUIET_OUTPUT);
+        game.startSimulation("");
+        checksum += game.isP2Win();
+    }
+    report("startSimulation", start, games);
+
+    // Whole games, setup included.
+    start = chrono::steady_clock::now();
+    for (long long i = 0; i < games; i++) {
+        BenchCPU game;
+        game.setOutputLevel(QUIET_OUTPUT);
+        game.startSimulation("");
+        while (!game.isP2Win()) {
+            game.cpuShoot();
+        }
+    }
+    report("full CPU game", start, games);
+
+    cout << "(checksum " << checksum << ")" << endl;
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include "../include/battleshipCpu.hpp"
+#include "../include/densityKernel.hpp"
+#include "../include/replay.hpp"
+#include <chrono>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+// Compares the density kernels (see DensityKernel) with the free segment loop they replaced,
+// on the boards of seeded games after every shot. Checks they all agree, then times them.
+// Usage: densityBench [numGames] [repeats]
+
+struct DensityCase {
+    Bitboard freePos;
+    bool isSunk[Fleet::numShips];
+    int shipLengths[Fleet::numShips]; // Of the unsunk ships.
+    int numShips;
+};
+
+// The free starts of each unsunk ship in each direction (the old calculateProbability).
+template <int ShipId>
+static void addSegmentStarts(const DensityCase &test, int density[10][10]) {
+    if (!test.isSunk[ShipId]) {
+        constexpr int shipLength = Fleet::getLength(ShipId);
+        for (int dir = UP; dir <= RIGHT; dir++) {
+            Bitboard starts = Board::getSegmentStarts<shipLength>(test.freePos, Direction(dir));
+            while (starts.any()) {
+                int cell = starts.lowest();
+                density[cell / 10][cell % 10]++;
+                starts.popLowest();
+            }
+        }
+    }
+    if constexpr (ShipId + 1 < Fleet::numShips) {
+        addSegmentStarts<ShipId + 1>(test, density);
+    }
+}
+
+static void calculateSegmentLoop(const DensityCase &test, int density[10][10]) {
+    for (int y = 0; y < 10; y++) {
+        for (int x = 0; x < 10; x++) {
+            density[y][x] = 0;
+        }
+    }
+    addSegmentStarts<0>(test, density);
+}
+
+int main(int argc, char* argv[]) {
+    long long numGames = (argc > 1) ? stoll(argv[1]) : 200;
+    long long repeats = (argc > 2) ? stoll(argv[2]) : 20;
+
+    // The board after every shot of seeded games.
+    vector<DensityCase> cases;
+    BattleshipCPU game;
+    for (long long i = 0; i < numGames; i++) {
+        game.reset();
+        Replay::setUpGame(game, i, APPROXIMATE_DENSITY, "");
+        while (!game.isP2Win()) {
+            game.cpuShoot();
+            Board &board = game.getBoard(1);
+            DensityCase test;
+            test.freePos = ~board.getShots() & Bitboard::full();
+            test.numShips = 0;
+            for (int shipId = 0; shipId < Fleet::numShips; shipId++) {
+                test.isSunk[shipId] = board.isShipSunk(shipId);
+                if (!test.isSunk[shipId]) {
+                    test.shipLengths[test.numShips++] = Fleet::getLength(shipId);
+                }
+            }
+            cases.push_back(test);
+        }
+    }
+
+    const KernelLevel levels[] = {SCALAR_KERNEL, SSE2_KERNEL, AVX2_KERNEL};
+    int numMismatches = 0;
+    for (const DensityCase &test : cases) {
+        int expected[10][10];
+        calculateSegmentLoop(test, expected);
+        for (KernelLevel level : levels) {
+            int density[10][10];
+            DensityKernel::calculate(level, test.freePos, test.shipLengths, test.numShips, density);
+            for (int cell = 0; cell < 100; cell++) {
+                numMismatches += (density[cell / 10][cell % 10] != expected[cell / 10][cell % 10]);
+            }
+        }
+    }
+    cout << cases.size() << " boards, " << numMismatches << " mismatched positions (dispatched level: "
+         << DensityKernel::getLevelName(DensityKernel::getLevel()) << ")" << endl;
+
+    long long checksum = 0;
+    long long calls = repeats * cases.size();
+    int density[10][10];
+    auto start = chrono::steady_clock::now();
+    for (long long i = 0; i < repeats; i++) {
+        for (const DensityCase &test : cases) {
+            calculateSegmentLoop(test, density);
+            checksum += density[i % 10][4];
+        }
+    }
+    double nanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    cout << "segment loop: " << nanos / calls << " ns/call" << endl;
+
+    for (KernelLevel level : levels) {
+        if (!DensityKernel::isSupported(level)) {
+            cout << DensityKernel::getLevelName(level) << ": not supported" << endl;
+            continue;
+        }
+        start = chrono::steady_clock::now();
+        for (long long i = 0; i < repeats; i++) {
+            for (const DensityCase &test : cases) {
+                DensityKernel::calculate(level, test.freePos, test.shipLengths, test.numShips, density);
+                checksum += density[i % 10][4];
+            }
+        }
+        nanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        cout << DensityKernel::getLevelName(level) << " run lengths: " << nanos / calls << " ns/call" << endl;
+    }
+
+    cout << "(checksum " << checksum << ")" << endl;
+    return (numMismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+#include "../include/battleshipCpu.hpp"
+#include "../include/replay.hpp"
+#include <chrono>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+// Plays the same seeded games with each endgame threshold (see EndgameSolver) and compares the
+// shots to win, the time per game and the slowest move with the endgame off. Also checks a fresh
+// solver (an empty table) plays the same moves as the one the games went through, at the last threshold.
+// Usage: endgameBench [numGames] [threshold]...
+
+struct ThresholdResult {
+    int threshold;
+    vector<int> gameShots;
+    double nanos = 0;
+    double worstMove = 0;
+    long long solvedMoves = 0; // Moves the endgame chose.
+};
+
+static ThresholdResult playGames(DensityEngine engine, int threshold, long long numGames) {
+    ThresholdResult result;
+    result.threshold = threshold;
+    BattleshipCPU game;
+    for (long long i = 0; i < numGames; i++) {
+        game.reset();
+        Replay::setUpGame(game, 1000 + i, engine, "");
+        game.setEndgameThreshold(threshold);
+        while (!game.isP2Win() && game.getBoard(1).getNumShots() < 100) {
+            auto start = chrono::steady_clock::now();
+            game.cpuShoot();
+            double nanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+            result.nanos += nanos;
+            result.worstMove = (nanos > result.worstMove) ? nanos : result.worstMove;
+            EndgameSolver &endgame = game.getEndgameSolver();
+            result.solvedMoves += (threshold > 0 && endgame.getLastFleetCount() <= threshold);
+        }
+        result.gameShots.push_back(game.getBoard(1).getNumShots());
+    }
+    return result;
+}
+
+// Games where a fresh CPU (and table) shoots differently from the one that played every game.
+static int countMismatches(DensityEngine engine, int threshold, long long numGames) {
+    BattleshipCPU warm;
+    int numMismatches = 0;
+    for (long long i = 0; i < numGames; i++) {
+        BattleshipCPU fresh;
+        warm.reset();
+        Replay::setUpGame(warm, 1000 + i, engine, "");
+        Replay::setUpGame(fresh, 1000 + i, engine, "");
+        warm.setEndgameThreshold(threshold);
+        fresh.setEndgameThreshold(threshold);
+        bool isSame = true;
+        while (!warm.isP2Win() && warm.getBoard(1).getNumShots() < 100) {
+            warm.cpuShoot();
+            fresh.cpuShoot();
+            isSame = isSame && (warm.getBoard(1).getShots() == fresh.getBoard(1).getShots());
+        }
+        numMismatches += !isSame;
+    }
+    return numMismatches;
+}
+
+int main(int argc, char* argv[]) {
+    long long numGames = (argc > 1) ? stoll(argv[1]) : 500;
+    vector<int> thresholds;
+    for (int i = 2; i < argc; i++) {
+        thresholds.push_back(stoi(argv[i]));
+    }
+    if (thresholds.empty()) {
+        thresholds = {4, 8, 12};
+    }
+
+    int numMismatches = 0;
+    const DensityEngine engines[] = {APPROXIMATE_DENSITY, EXACT_DENSITY};
+    for (DensityEngine engine : engines) {
+        cout << BattleshipCPU::getEngineName(engine) << " (" << numGames << " games):" << endl;
+        ThresholdResult off = playGames(engine, 0, numGames);
+        vector<ThresholdResult> results = {off};
+        for (int threshold : thresholds) {
+            results.push_back(playGames(engine, threshold, numGames));
+        }
+
+        for (const ThresholdResult &result : results) {
+            long long totalShots = 0;
+            int better = 0, worse = 0;
+            for (long long i = 0; i < numGames; i++) {
+                totalShots += result.gameShots[i];
+                better += (result.gameShots[i] < off.gameShots[i]);
+                worse += (result.gameShots[i] > off.gameShots[i]);
+            }
+            cout << "  threshold " << result.threshold << ": " << double(totalShots) / numGames << " shots, "
+                 << result.nanos / numGames / 1e3 << " us/game, slowest move " << result.worstMove / 1e3
+                 << " us, " << result.solvedMoves << " moves solved, " << better << " games better, "
+                 << worse << " worse" << endl;
+        }
+
+        int mismatches = countMismatches(engine, thresholds.back(), numGames / 5);
+        cout << "  " << mismatches << " games differ with a fresh table" << endl;
+        numMismatches += mismatches;
+    }
+    return (numMismatches == 0) ? 0 : 1;
+}
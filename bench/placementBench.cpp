@@ -0,0 +1,107 @@
+#include "../include/battleship.hpp"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+using namespace std;
+
+// Throughput and uniformity of random fleet placement.
+// Usage: placementBench [numBoards]
+
+// Exposes the placement internals that are checked.
+class BenchGame : public Battleship {
+    public:
+        using Battleship::placeShips;
+        using Battleship::placeShipRandomly;
+};
+
+// Checks that every placement index points at the placement starting there.
+template <int Length>
+static bool checkIndices() {
+    const PlacementTable<Length> &table = placementTable<Length>;
+    for (int i = 0; i < table.count; i++) {
+        if (table.getIndex(table.placements[i].start, table.placements[i].step) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Chi-squared statistic of the counts against equal expected counts.
+static double chiSquared(const long long counts[], int numBins, long long total) {
+    double expected = double(total) / numBins;
+    double statistic = 0;
+    for (int i = 0; i < numBins; i++) {
+        statistic += ((counts[i] - expected) * (counts[i] - expected)) / expected;
+    }
+    return statistic;
+}
+
+// Passes if the statistic is within 4 standard deviations of its mean (degrees of freedom).
+static bool reportUniformity(string name, double statistic, int numBins) {
+    int freedom = numBins - 1;
+    bool isUniform = statistic < freedom + (4 * sqrt(2.0 * freedom));
+    cout << name << ": chi-squared " << statistic << " with " << freedom << " degrees of freedom, "
+         << (isUniform ? "uniform" : "NOT UNIFORM") << endl;
+    return isUniform;
+}
+
+int main(int argc, char* argv[]) {
+    long long numBoards = (argc > 1) ? stoll(argv[1]) : 2000000;
+    long long checksum = 0;
+    BenchGame game;
+    game.setSeed(12345);
+    Board board;
+
+    bool isValid = checkIndices<2>() && checkIndices<3>() && checkIndices<4>() && checkIndices<5>();
+    cout << "Placement indices: " << (isValid ? "ok" : "WRONG") << endl;
+
+    // Throughput.
+    auto start = chrono::steady_clock::now();
+    for (long long i = 0; i < numBoards; i++) {
+        board.clear();
+        game.placeShips(board);
+        checksum += board.getShipMask(Board::numShips - 1).lo & 1;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "placeShips: " << (seconds * 1e9) / numBoards << " ns/board (" << numBoards / seconds << " boards/sec)" << endl;
+
+    // The carrier goes first, so each of its placements should be equally likely.
+    const PlacementTable<5> &carrierTable = placementTable<5>;
+    long long carrierCounts[PlacementTable<5>::count] = {0};
+    long long samples = numBoards / 4;
+    for (long long i = 0; i < samples; i++) {
+        board.clear();
+        game.placeShipRandomly<0>(board);
+        for (int j = 0; j < carrierTable.count; j++) {
+            carrierCounts[j] += board.getShipMask(0) == carrierTable.placements[j].mask;
+        }
+    }
+    isValid &= reportUniformity("Carrier on an empty board", chiSquared(carrierCounts, carrierTable.count, samples), carrierTable.count);
+
+    // The patrol boat goes last, so on a fixed board it should be equally likely on each free placement.
+    const PlacementTable<2> &patrolTable = placementTable<2>;
+    Board fixedBoard;
+    game.placeShipRandomly<0>(fixedBoard);
+    game.placeShipRandomly<1>(fixedBoard);
+    game.placeShipRandomly<2>(fixedBoard);
+    game.placeShipRandomly<3>(fixedBoard);
+    int freeIndices[PlacementTable<2>::count];
+    int numFree = 0;
+    for (int j = 0; j < patrolTable.count; j++) {
+        if ((patrolTable.placements[j].mask & fixedBoard.occupied()).empty()) {
+            freeIndices[numFree++] = j;
+        }
+    }
+    long long patrolCounts[PlacementTable<2>::count] = {0};
+    for (long long i = 0; i < samples; i++) {
+        board = fixedBoard;
+        game.placeShipRandomly<4>(board);
+        for (int j = 0; j < numFree; j++) {
+            patrolCounts[j] += board.getShipMask(4) == patrolTable.placements[freeIndices[j]].mask;
+        }
+    }
+    isValid &= reportUniformity("Patrol boat on a fixed board", chiSquared(patrolCounts, numFree, samples), numFree);
+
+    cout << "(checksum " << checksum << ")" << endl;
+    return isValid ? 0 : 1;
+}
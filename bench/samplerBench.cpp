@@ -0,0 +1,93 @@
+#include "../include/battleshipCpu.hpp"
+#include "../include/replay.hpp"
+#include <chrono>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+// Plays sampling games with each number of sampler threads, with and without a latency budget,
+// and checks every move and estimate: the move is a position that hasn't been shot, the estimate
+// is 0 on every shot position and a share everywhere else, and the game is won within 100 shots.
+// The games are reset and reused, so the workers are stopped and started again between them.
+// Usage: samplerBench [numGames] [numThreads]...
+
+struct SamplerResult {
+    long long turns = 0;
+    long long shots = 0;
+    long long samples = 0;
+    double nanos = 0;
+    int numErrors = 0;
+};
+
+// Checks an estimate against the shots of the view, counting what's wrong.
+static int checkEstimate(const TargetView &view, const double occupancy[100]) {
+    Bitboard shots = view.misses;
+    for (int i = 0; i < Fleet::numShips; i++) {
+        shots |= view.shipHits[i];
+    }
+    int numErrors = 0;
+    for (int cell = 0; cell < 100; cell++) {
+        bool isValid = shots.test(cell) ? occupancy[cell] == 0 : (occupancy[cell] >= 0 && occupancy[cell] <= 1);
+        numErrors += !isValid;
+    }
+    return numErrors;
+}
+
+static SamplerResult playGames(int numThreads, double latencyBudget, long long numGames) {
+    SamplerResult result;
+    BattleshipCPU game;
+    FleetSampler checker; // Estimates each turn's view on as many threads as the game.
+    checker.setNumThreads(numThreads);
+    checker.setLatencyBudget(latencyBudget);
+    double occupancy[100];
+
+    for (long long i = 0; i < numGames; i++) {
+        game.reset();
+        Replay::setUpGame(game, 1000 + i, MONTE_CARLO_DENSITY, "");
+        game.getSampler().setNumThreads(numThreads);
+        game.getSampler().setLatencyBudget(latencyBudget);
+        checker.setSeed(2000 + i);
+
+        while (!game.isP2Win() && game.getBoard(1).getNumShots() < 100) {
+            checker.estimate(game.getBoard(1).getTargetView(), occupancy);
+            result.numErrors += checkEstimate(game.getBoard(1).getTargetView(), occupancy);
+
+            Bitboard shots = game.getBoard(1).getShots();
+            auto start = chrono::steady_clock::now();
+            game.cpuShoot();
+            result.nanos += chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+            result.numErrors += shots.test(game.getLastMove());
+            result.samples += game.getSampler().getLastSampleCount();
+            result.turns++;
+        }
+        result.numErrors += !game.isP2Win();
+        result.shots += game.getBoard(1).getNumShots();
+    }
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    long long numGames = (argc > 1) ? stoll(argv[1]) : 20;
+    vector<int> threadCounts;
+    for (int i = 2; i < argc; i++) {
+        threadCounts.push_back(stoi(argv[i]));
+    }
+    if (threadCounts.empty()) {
+        threadCounts = {1, 2, 4};
+    }
+
+    int numErrors = 0;
+    for (int numThreads : threadCounts) {
+        const double budgets[] = {0, 0.05};
+        for (double budget : budgets) {
+            SamplerResult result = playGames(numThreads, budget, numGames);
+            cout << numThreads << " threads, budget " << budget << " ms: " << double(result.shots) / numGames
+                 << " shots, " << result.nanos / result.turns / 1e3 << " us per turn, "
+                 << double(result.samples) / result.turns << " samples per turn, " << result.numErrors
+                 << " errors" << endl;
+            numErrors += result.numErrors;
+        }
+    }
+    cout << (numErrors == 0 ? "PASS" : "FAIL") << ": every move and estimate is legal" << endl;
+    return (numErrors == 0) ? 0 : 1;
+}
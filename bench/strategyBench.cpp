@@ -0,0 +1,32 @@
+#include "../include/simulator.hpp"
+#include <iostream>
+using namespace std;
+
+// Compares the built-in targeting strategies on the same fleets: shots to win and time per turn.
+// Usage: strategyBench [numGames] [seed]
+
+int main(int argc, char* argv[]) {
+    long long numGames = (argc > 1) ? stoll(argv[1]) : 1000;
+    uint64_t seed = (argc > 2) ? stoull(argv[2]) : 1;
+    const DensityEngine engines[] = {RANDOM_TARGETING, CHECKERBOARD_TARGETING, APPROXIMATE_DENSITY,
+                                     EXACT_DENSITY, MONTE_CARLO_DENSITY};
+
+    for (DensityEngine engine : engines) {
+        // Sampling is much slower, so it plays fewer games.
+        long long currGames = (engine == MONTE_CARLO_DENSITY) ? (numGames / 20) + 1 : numGames;
+        Simulator simulator(1);
+        simulator.setDensityEngine(engine);
+        simulator.setSeed(seed);
+        SimulationResult result = simulator.run(currGames);
+
+        long long turns = 0;
+        for (int shots = 0; shots < int(result.shotHistogram.size()); shots++) {
+            turns += shots * result.shotHistogram[shots];
+        }
+        cout << BattleshipCPU::getEngineName(engine) << ": " << currGames << " games, "
+             << double(turns) / currGames << " shots to win, "
+             << (result.seconds * 1e6) / turns << " us per turn (p99 "
+             << result.turnLatency.getPercentile(99) / 1000.0 << " us)" << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "../include/battleship.hpp"
+#include "../include/layoutValidator.hpp"
+#include <chrono>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+// Throughput of layout validation on valid fleets and on fuzzed ones.
+// Usage: validatorBench [numLayouts]
+
+// Exposes the placement and validation internals.
+class BenchGame : public Battleship {
+    public:
+        using Battleship::placeShips;
+        using Battleship::isShipPlacementValid;
+};
+
+int main(int argc, char* argv[]) {
+    long long numLayouts = (argc > 1) ? stoll(argv[1]) : 1000000;
+    BenchGame game;
+    game.setSeed(2024);
+    FastRandom random(99);
+
+    // Half valid fleets, half with one position of one ship moved somewhere random.
+    vector<ShipLayout> layouts(numLayouts);
+    vector<Board> boards(numLayouts / 10);
+    for (long long i = 0; i < numLayouts; i++) {
+        Board board;
+        game.placeShips(board);
+        ShipLayout &currLayout = layouts[i];
+        for (int j = 0; j < Fleet::numShips; j++) {
+            currLayout.ships[j] = board.getShipMask(j);
+        }
+        if (i % 2) {
+            int shipId = random.nextBelow(Fleet::numShips);
+            Bitboard &ship = currLayout.ships[shipId];
+            ship.reset(ship.select(random.nextBelow(ship.count())));
+            ship.set(random.nextBelow(100));
+        }
+        if (i < (long long)boards.size()) {
+            for (int j = 0; j < Fleet::numShips; j++) {
+                Bitboard mask = currLayout.ships[j];
+                while (mask.any()) {
+                    boards[i].setPiece(mask.lowest() % 10, mask.lowest() / 10, Board::getShipType(j));
+                    mask.popLowest();
+                }
+            }
+        }
+    }
+
+    vector<LayoutError> errors(numLayouts);
+    auto start = chrono::steady_clock::now();
+    size_t numValid = LayoutValidator::validateBatch(layouts.data(), layouts.size(), errors.data());
+    double nanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    cout << "validateBatch: " << nanos / numLayouts << " ns/layout (" << numValid << " of " << numLayouts << " valid)" << endl;
+
+    long long errorCounts[LAYOUT_OVERLAP + 1] = {0};
+    for (LayoutError error : errors) {
+        errorCounts[error]++;
+    }
+    for (int i = LAYOUT_OK; i <= LAYOUT_OVERLAP; i++) {
+        cout << "  " << LayoutValidator::getMessage(LayoutError(i)) << ": " << errorCounts[i] << endl;
+    }
+
+    // The board check used when loading a board file.
+    long long numBoardsValid = 0;
+    start = chrono::steady_clock::now();
+    for (Board &board : boards) {
+        numBoardsValid += game.isShipPlacementValid(board);
+    }
+    nanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    cout << "isShipPlacementValid: " << nanos / boards.size() << " ns/board (" << numBoardsValid << " of " << boards.size() << " valid)" << endl;
+    return 0;
+}
@@ -0,0 +1,60 @@
+#ifndef BATCHDRIVER_HPP
+#define BATCHDRIVER_HPP
+
+#include "gamePool.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// How one scripted game went.
+struct BatchGameResult {
+    int numPlayers = 1;
+    int turns = 0; // Shots taken by Player 1.
+    int rejectedShots = 0; // Shots at positions already hit, or that weren't co-ordinates.
+    int winner = 0; // 1 or 2 (the CPU), 3 for a draw, 0 if the shots ran out first.
+    double micros = 0;
+    string error; // Set if the game couldn't start (e.g. a missing board file).
+};
+
+// Plays games from a script, one after another, through the same calls as an interactive game.
+// A script is read in one go, one command per line (# starts a comment):
+//   players 1|2             Number of players (1 plays against the CPU).
+//   board 1|2 fileName      Loads a player's ships from the boards folder ("board 1 -" places them randomly).
+//   seed n|random           Seeds the ship placements (and the CPU). Repeated games use n, n + 1, ...
+//   engine approximate|exact|sampling|random|checkerboard
+//   output quiet|text|full  What each game shows (quiet by default).
+//   shots A1 B2 ...         Shots to take, in order (alternating players in a two player game).
+//   play [repeats]          Plays the game(s) with the settings so far, then clears the shots.
+// Invalid shots are skipped, like re-entering them in a live game. A game ends when a player
+// wins or the shots run out.
+class BatchDriver {
+    public:
+        BatchDriver();
+        ~BatchDriver();
+
+        // Plays every game in the script, writing a line per game and a summary to out.
+        // Throws runtime_error (with the line number) if a command is invalid.
+        void run(const string &script, ostream &out);
+        const vector<BatchGameResult>& getResults() { return results; }
+
+        // Reads a whole script file at once ("-" reads stdin). Throws runtime_error if unreadable.
+        static string readScript(const string &fileName);
+    private:
+        int numPlayers;
+        string boardFiles[2]; // Empty if the ships are placed randomly.
+        bool isSeeded;
+        uint64_t seed;
+        DensityEngine engine;
+        OutputLevel outputLevel;
+        vector<string> shots;
+        vector<BatchGameResult> results;
+        GamePool games;
+
+        // Methods.
+        BatchGameResult playGame(uint64_t gameSeed);
+        void printResult(const BatchGameResult &result, ostream &out);
+        void printSummary(ostream &out);
+};
+
+#endif
@@ -3,50 +3,78 @@
 
 #include "ship.hpp"
 #include "coordinate.hpp"
+#include "board.hpp"
+#include "fastRandom.hpp"
+#include "renderer.hpp"
+#include "metrics.hpp"
 #include <vector>
-#include <unordered_map>
+#include <utility>
 using namespace std;
-enum Direction {UP, DOWN, LEFT, RIGHT};
+
+class LayoutBank;
 
 class Battleship {
     public:
         Battleship();
         virtual ~Battleship(); // Virtual ensures subclass deconstructor runs as well.
+        virtual void reset(); // Back to a new game's state, so the object can be reused (see ObjectPool).
         void startGame(int numPlayers, bool loadP1ShipFile, bool loadP2ShipFile);
+        void startSimulation(const string &p1Layout);
         void showBoard();
         void setGameFinished(bool status) { isFinished = status; }
+        void setOutputLevel(OutputLevel level) { outputLevel = level; }
+        OutputLevel getOutputLevel() { return outputLevel; }
+        Renderer& getRenderer() { return renderer; }
+        GameMetrics& getMetrics() { return metrics; } // This game's (see Metrics).
+        void setBoardFile(int player, string fileName);
+        // The CPU's fleet is drawn from the bank instead of placed randomly (nullptr for random).
+        void setLayoutBank(const LayoutBank* bank) { layoutBank = bank; }
+        virtual void setSeed(uint64_t seed) { this->seed = seed; random.setSeed(seed); } // Seeds the ship placements.
+        uint64_t getSeed() { return seed; }
+        Board& getBoard(int player) { return (player == 1) ? p1Board : p2Board; }
+        string getBoardLayout(int player);
+        void setBoardLayout(int player, const string &layout); // Throws runtime_error if invalid.
         void shoot(char charX, int y);
+        static void parseCoordinate(const string &xy, char &x, int &y); // Throws logic_error if invalid.
         bool isP1Win() { return p1Win; }
         bool isP2Win() { return p2Win; }
         bool isGameFinished() { return isFinished; }
         int getNumPlayers() { return numPlayers; }
         int getCurrPlayer() { return currPlayer; }
     protected:
-        static const char emptySpace = '-'; // static makes it useable in switch, case.
+        static const char emptySpace = Board::emptySpace; // static makes it useable in switch, case.
         int numPlayers;
         int currPlayer;
         bool p1Win;
         bool p2Win;
         bool isFinished;
+        OutputLevel outputLevel;
+        Renderer renderer;
+        GameMetrics metrics;
+        string p1BoardFile;
+        string p2BoardFile;
+        const LayoutBank* layoutBank; // Not owned.
+        uint64_t seed;
+        FastRandom random; // Used for ship placements.
 
-        char** p1Board;
-        char** p2Board;
+        Board p1Board;
+        Board p2Board;
         int p1ShipCount;
         int p2ShipCount;
-        unordered_map<char, Ship> p1Ships;
-        unordered_map<char, Ship> p2Ships;
+        Ship p1Ships[Fleet::numShips]; // Indexed by ship id.
+        Ship p2Ships[Fleet::numShips];
 
         // Methods.
         // Ship placements.
-        void placeShips(char** board);
-        void getShipsFromFile(string fileName, char** currBoard);
-        void setShipData(unordered_map<char, Ship> &ships);
-        bool isShipPlacementValid(char** board);
-        bool isShipValid(char** board, vector<Coordinate> &shipPos, char shipType, int shipLength);
-        vector<Direction> getValidDirections(int x, int y, int shipLength, char** board);
-
-        // Other
-        bool isPosHit(char boardPiece);
+        void initBoards(int numPlayers);
+        void placeShips(Board &board);
+        template <int... ShipIds>
+        void placeFleet(Board &board, integer_sequence<int, ShipIds...>);
+        template <int ShipId>
+        void placeShipRandomly(Board &board);
+        void getShipsFromFile(string fileName, Board &currBoard);
+        void setShipData(Ship ships[]);
+        bool isShipPlacementValid(Board &board);
 };
 
 #endif
\ No newline at end of file
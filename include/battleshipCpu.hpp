@@ -2,34 +2,52 @@
 #define BATTLESHIPCPU_HPP
 
 #include "battleship.hpp"
-#include <queue>
+#include "heuristicStrategy.hpp"
+#include "exactStrategy.hpp"
+#include "samplingStrategy.hpp"
+#include "randomStrategy.hpp"
+#include "checkerboardStrategy.hpp"
+
+// The built-in targeting strategies (see TargetingStrategy).
+// APPROXIMATE_DENSITY: HeuristicStrategy, an approximate density with queued moves to sink a found ship.
+// EXACT_DENSITY: ExactStrategy, ExactDensity placement counts, used for hunting and sinking.
+// MONTE_CARLO_DENSITY: SamplingStrategy, FleetSampler estimates from whole fleets, used for hunting and sinking.
+// RANDOM_TARGETING: RandomStrategy, any unshot position (a baseline).
+// CHECKERBOARD_TARGETING: CheckerboardStrategy, checkerboard hunting and shooting around hits (a baseline).
+enum DensityEngine {APPROXIMATE_DENSITY, EXACT_DENSITY, MONTE_CARLO_DENSITY, RANDOM_TARGETING, CHECKERBOARD_TARGETING};
 
 class BattleshipCPU : public Battleship {
     public:
         BattleshipCPU();
         ~BattleshipCPU();
+        void reset();
         void cpuShoot();
+        void setDensityEngine(DensityEngine engine);
+        // Uses a strategy that isn't built in (until the next reset or setDensityEngine).
+        // The strategy is reset against Player 1's board, and must outlive its use.
+        void setStrategy(TargetingStrategy &strategy);
+        void setSeed(uint64_t seed); // Seeds the ship placements and the CPU's decisions.
+        int getLastMove() { return lastMove; }
+        static string getEngineName(DensityEngine engine);
+        static bool getEngine(string name, DensityEngine &engine); // False if the name is unknown.
+        FleetSampler& getSampler() { return samplingStrategy.getSampler(); }
+        // Fleets left when the density strategies switch to solving the endgame (0, the default, turns
+        // it off). It's kept by reset. Call it outside of play: turning it on the first time allocates.
+        void setEndgameThreshold(int threshold) { endgame.setThreshold(threshold); }
+        EndgameSolver& getEndgameSolver() { return endgame; }
     protected:
-        int** probBoard; // For CPU probability.
-        bool sinkMode; // True, if it's currently sinking a found ship.
-        Ship prevShipHit;
-        unordered_map<string, queue<Coordinate>> shipPosFound; // Discovered ship positions.
-        unordered_map<string, queue<Coordinate>> cpuMoves; // Moves to sink the ship(s) found.
+        // Every built-in strategy is kept, so switching (or reusing the CPU) allocates nothing.
+        HeuristicStrategy heuristicStrategy;
+        ExactStrategy exactStrategy;
+        SamplingStrategy samplingStrategy;
+        RandomStrategy randomStrategy;
+        CheckerboardStrategy checkerboardStrategy;
+        TargetingStrategy* strategy; // The one in use.
+        EndgameSolver endgame; // Shared by the density strategies.
+        int lastMove; // Position of the CPU's last shot (y * 10 + x), or -1.
 
         // Methods.
-        void calculateProbability();
-        bool checkParity(int x, int y);
-        Coordinate getNextMove(); // Get move based on probability density.
-        Coordinate getCpuMove();
-        void setCpuMoves(int x, int y, Ship thatShip);
-        void findShip(int x, int y, Ship thatShip);
-        void sinkShip(int x, int y, Ship thatShip);
-        
-        void backTrackShot(int x, int y);
-        void setAltMoves(Direction dir, Coordinate prevShipMove);
-        void setPrevShip();
-        Direction getDirection(Coordinate first, Coordinate last);
-        bool canShipExist(int shipLength, Coordinate currPos, Direction dir);
+        void initCpu();
 };
 
-#endif
\ No newline at end of file
+#endif
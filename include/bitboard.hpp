@@ -0,0 +1,93 @@
+#ifndef BITBOARD_HPP
+#define BITBOARD_HPP
+
+#include <cstdint>
+
+// The 100 board positions packed into 128 bits, position (x, y) is bit y * 10 + x.
+// Bits 100 to 127 are never part of the board.
+struct Bitboard {
+    uint64_t lo; // Bits 0 to 63.
+    uint64_t hi; // Bits 64 to 127.
+
+    constexpr Bitboard() : lo(0), hi(0) { }
+    constexpr Bitboard(uint64_t lo, uint64_t hi) : lo(lo), hi(hi) { }
+
+    static constexpr Bitboard cell(int index) {
+        return (index < 64) ? Bitboard(uint64_t(1) << index, 0) : Bitboard(0, uint64_t(1) << (index - 64));
+    }
+    static constexpr Bitboard cell(int x, int y) { return cell((y * 10) + x); }
+    // Every position on the board.
+    static constexpr Bitboard full() { return Bitboard(~uint64_t(0), (uint64_t(1) << 36) - 1); }
+
+    constexpr bool test(int index) const {
+        return (index < 64) ? ((lo >> index) & 1) : ((hi >> (index - 64)) & 1);
+    }
+    constexpr bool test(int x, int y) const { return test((y * 10) + x); }
+    constexpr bool empty() const { return (lo | hi) == 0; }
+    constexpr bool any() const { return (lo | hi) != 0; }
+    int count() const { return popcount(lo) + popcount(hi); }
+    // Index of the lowest set bit (the bitboard must not be empty).
+    int lowest() const { return lo ? __builtin_ctzll(lo) : 64 + __builtin_ctzll(hi); }
+    // Index of the nth set bit, counting from 0 (n must be less than count()).
+    int select(int n) const {
+        int loCount = popcount(lo);
+        return (n < loCount) ? selectWord(lo, n) : 64 + selectWord(hi, n - loCount);
+    }
+    // Without the popcnt instruction, the builtin is a library call, so count with bit operations.
+    static int popcount(uint64_t word) {
+#ifdef __POPCNT__
+        return __builtin_popcountll(word);
+#else
+        word = word - ((word >> 1) & 0x5555555555555555ULL);
+        word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+        word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return int((word * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+    // Finds the byte holding the nth set bit from running byte counts, then walks that byte.
+    static int selectWord(uint64_t word, int n) {
+        const uint64_t ones = 0x0101010101010101ULL;
+        uint64_t counts = word - ((word >> 1) & 0x5555555555555555ULL);
+        counts = (counts & 0x3333333333333333ULL) + ((counts >> 2) & 0x3333333333333333ULL);
+        counts = (counts + (counts >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        uint64_t runningCounts = counts * ones; // Byte i counts the set bits in bytes 0 to i.
+
+        // The high bit of a byte is set once its running count passes n.
+        uint64_t passed = ((runningCounts | (ones << 7)) - ((n + 1) * ones)) & (ones << 7);
+        int byteShift = __builtin_ctzll(passed) - 7;
+        n -= ((runningCounts << 8) >> byteShift) & 0xFF;
+
+        uint64_t byte = (word >> byteShift) & 0xFF;
+        for (int i = 0; i < n; i++) {
+            byte &= byte - 1;
+        }
+        return byteShift + __builtin_ctzll(byte);
+    }
+    void popLowest() {
+        if (lo) {
+            lo &= lo - 1;
+        } else {
+            hi &= hi - 1;
+        }
+    }
+
+    // Shifts towards higher positions (n is between 1 and 63).
+    constexpr Bitboard shiftUp(int n) const { return Bitboard(lo << n, (hi << n) | (lo >> (64 - n))); }
+    // Shifts towards lower positions (n is between 1 and 63).
+    constexpr Bitboard shiftDown(int n) const { return Bitboard((lo >> n) | (hi << (64 - n)), hi >> n); }
+
+    void set(int index) { *this |= cell(index); }
+    void reset(int index) { *this &= ~cell(index); }
+
+    constexpr Bitboard operator&(const Bitboard &other) const { return Bitboard(lo & other.lo, hi & other.hi); }
+    constexpr Bitboard operator|(const Bitboard &other) const { return Bitboard(lo | other.lo, hi | other.hi); }
+    constexpr Bitboard operator^(const Bitboard &other) const { return Bitboard(lo ^ other.lo, hi ^ other.hi); }
+    constexpr Bitboard operator~() const { return Bitboard(~lo, ~hi); }
+    Bitboard &operator&=(const Bitboard &other) { lo &= other.lo; hi &= other.hi; return *this; }
+    Bitboard &operator|=(const Bitboard &other) { lo |= other.lo; hi |= other.hi; return *this; }
+    Bitboard &operator^=(const Bitboard &other) { lo ^= other.lo; hi ^= other.hi; return *this; }
+    constexpr bool operator==(const Bitboard &other) const { return lo == other.lo && hi == other.hi; }
+    constexpr bool operator!=(const Bitboard &other) const { return !(*this == other); }
+};
+
+#endif
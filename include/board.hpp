@@ -0,0 +1,115 @@
+#ifndef BOARD_HPP
+#define BOARD_HPP
+
+#include "bitboard.hpp"
+#include "fleet.hpp"
+enum Direction {UP, DOWN, LEFT, RIGHT};
+enum ShotResult {SHOT_MISS, SHOT_HIT, SHOT_SUNK, SHOT_REPEATED};
+
+// What the shooter knows about a board.
+// Hits are announced with the ship's name, so they are known per ship.
+struct TargetView {
+    Bitboard misses;
+    Bitboard shipHits[5];
+    bool isSunk[5];
+};
+
+// A player's board, stored as bitboards: one per ship plus the hits and misses.
+class Board {
+    public:
+        static const int numShips = Fleet::numShips;
+        static const char emptySpace = '-';
+
+        Board();
+        ~Board();
+        void clear();
+
+        // Pieces (used for text input and output).
+        char getPiece(int x, int y);
+        void setPiece(int x, int y, char piece);
+        static int getShipId(char shipType); // -1 if it's not a ship.
+        static char getShipType(int shipId) { return Fleet::ships[shipId].type; }
+        static int getShipLength(int shipId) { return Fleet::getLength(shipId); }
+
+        // Placement.
+        bool isEmpty(int x, int y) { return !(occupied() | shots).test(x, y); }
+        bool canPlaceShip(int x, int y, Direction dir, int shipLength);
+        void placeShip(int shipId, int x, int y, Direction dir, int shipLength);
+        void placeShip(int shipId, Bitboard mask) { ships[shipId] |= mask; }
+
+        // Shots.
+        ShotResult shoot(int x, int y, int &shipId);
+        bool isPosHit(int x, int y) { return shots.test(x, y); }
+        int getNumShots() { return numShots; }
+        int getShot(int index) { return shotOrder[index]; } // Position (y * 10 + x) of a shot, in order.
+        bool isSegmentFree(int x, int y, Direction dir, int length, Bitboard ignoredShots = Bitboard());
+        template <int Length>
+        Bitboard getFreeSegmentStarts(Direction dir) { return getSegmentStarts<Length>(~shots & Bitboard::full(), dir); }
+        template <int Length>
+        static Bitboard getSegmentStarts(Bitboard freePos, Direction dir);
+        bool isShipSunk(int shipId) { return (ships[shipId] & ~hits).empty(); }
+        int getShipHealth(int shipId) { return (ships[shipId] & ~hits).count(); }
+
+        Bitboard getShipMask(int shipId) { return ships[shipId]; }
+        Bitboard getHits() { return hits; }
+        Bitboard getMisses() { return misses; }
+        Bitboard getShots() { return shots; }
+        TargetView getTargetView();
+        Bitboard occupied() { return ships[0] | ships[1] | ships[2] | ships[3] | ships[4]; }
+
+        static Bitboard getSegment(int x, int y, Direction dir, int length);
+        static constexpr Bitboard getColumns(int first, int last);
+    private:
+        Bitboard ships[numShips];
+        Bitboard hits;
+        Bitboard misses;
+        Bitboard shots; // Hits and misses.
+        unsigned char shotOrder[100];
+        int numShots;
+};
+
+// Every position in the columns first to last.
+constexpr Bitboard Board::getColumns(int first, int last) {
+    Bitboard columns;
+    for (int cell = 0; cell < 100; cell++) {
+        if (cell % 10 >= first && cell % 10 <= last) {
+            columns = columns | Bitboard::cell(cell);
+        }
+    }
+    return columns;
+}
+
+// Returns every position where a segment of that length, going in that direction, only covers free positions.
+// Each step ANDs the free positions with themselves shifted along the direction.
+template <int Length>
+Bitboard Board::getSegmentStarts(Bitboard freePos, Direction dir) {
+    // Horizontal segments can't wrap onto the next row.
+    constexpr Bitboard fromLeft = getColumns(Length - 1, 9);
+    constexpr Bitboard fromRight = getColumns(0, 10 - Length);
+
+    Bitboard starts = freePos;
+    switch (dir) {
+        case UP:
+            for (int i = 1; i < Length; i++) {
+                starts &= freePos.shiftUp(10 * i);
+            }
+            return starts;
+        case DOWN:
+            for (int i = 1; i < Length; i++) {
+                starts &= freePos.shiftDown(10 * i);
+            }
+            return starts;
+        case LEFT:
+            for (int i = 1; i < Length; i++) {
+                starts &= freePos.shiftUp(i);
+            }
+            return starts & fromLeft;
+        default:
+            for (int i = 1; i < Length; i++) {
+                starts &= freePos.shiftDown(i);
+            }
+            return starts & fromRight;
+    }
+}
+
+#endif
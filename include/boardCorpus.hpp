@@ -0,0 +1,70 @@
+#ifndef BOARDCORPUS_HPP
+#define BOARDCORPUS_HPP
+
+#include "layoutValidator.hpp"
+#include <string>
+#include <vector>
+using namespace std;
+
+// A valid fleet from the corpus, as the placement index of each ship.
+struct PackedFleet {
+    unsigned char placements[Fleet::numShips];
+};
+
+enum ParseError {
+    PARSE_OK,
+    PARSE_UNREADABLE, // The file or directory can't be read.
+    PARSE_INVALID_PIECE,
+    PARSE_TOO_MANY_COLUMNS,
+    PARSE_NOT_ENOUGH_COLUMNS,
+    PARSE_TOO_MANY_ROWS,
+    PARSE_NOT_ENOUGH_ROWS,
+    PARSE_INVALID_PLACEMENT // See the layout error.
+};
+
+// A board that couldn't be loaded.
+struct CorpusError {
+    string source; // File name.
+    int board; // Position of the board in its file (from 0).
+    ParseError error;
+    int row; // Where the error is (from 1, or 0 if it's about the whole board).
+    int column;
+    LayoutError layout;
+};
+
+// Loads many boards in the boards folder's text format (10 rows of 10 pieces, spaces between them).
+// A file can hold several boards separated by blank lines. Files are memory mapped, and the boards
+// are parsed and validated in parallel. Errors are collected instead of thrown.
+class BoardCorpus {
+    public:
+        BoardCorpus(int numThreads);
+        ~BoardCorpus();
+        bool loadFile(string path); // False if it can't be read (the error is added too).
+        bool loadDirectory(string path); // Every file in the directory, in name order.
+
+        int size() { return fleets.size(); }
+        const vector<PackedFleet>& getFleets() { return fleets; }
+        const vector<CorpusError>& getErrors() { return errors; }
+        Bitboard getShipMask(int board, int shipId);
+        string getLayout(int board); // The 100 board pieces, row by row (see Battleship::startSimulation).
+        static string getMessage(const CorpusError &error);
+    private:
+        static const int boardsPerTask = 256;
+        int numThreads;
+        vector<PackedFleet> fleets;
+        vector<CorpusError> errors;
+
+        // A board's text inside a mapped file.
+        struct BoardText {
+            const char* begin;
+            const char* end;
+            int board;
+        };
+
+        // Methods.
+        void parseFiles(const vector<string> &paths);
+        static void splitBoards(const char* data, size_t size, vector<BoardText> &boards);
+        static ParseError parseBoard(const BoardText &text, PackedFleet &fleet, int &row, int &column, LayoutError &layout);
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef CHECKERBOARDSTRATEGY_HPP
+#define CHECKERBOARDSTRATEGY_HPP
+
+#include "targetingStrategy.hpp"
+#include "fastRandom.hpp"
+
+// Baseline hunt and target: hunts at random on one colour of a checkerboard (every ship covers
+// one), and after a hit shoots the positions around it (most recent hit first) until none are left.
+class CheckerboardStrategy : public TargetingStrategy {
+    public:
+        CheckerboardStrategy();
+        void reset(Board &board);
+        void setSeed(uint64_t seed) { random.setSeed(seed); }
+        Coordinate chooseMove();
+        void recordShot(int x, int y, ShotResult result, int shipId);
+    protected:
+        Board* board;
+        FastRandom random;
+        unsigned char targets[100]; // Positions to shoot next (a stack).
+        int numTargets;
+        Bitboard queued; // Positions that have been added to targets.
+
+        // Methods.
+        void pushTarget(int x, int y);
+        static constexpr Bitboard getHuntPositions();
+        static const Bitboard huntPositions;
+};
+
+// The positions where x + y is even (every ship of 2 or more covers one).
+constexpr Bitboard CheckerboardStrategy::getHuntPositions() {
+    Bitboard positions;
+    for (int cell = 0; cell < 100; cell++) {
+        if (((cell % 10) + (cell / 10)) % 2 == 0) {
+            positions = positions | Bitboard::cell(cell);
+        }
+    }
+    return positions;
+}
+
+#endif
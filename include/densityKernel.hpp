@@ -0,0 +1,28 @@
+#ifndef DENSITYKERNEL_HPP
+#define DENSITYKERNEL_HPP
+
+#include "bitboard.hpp"
+#include <string>
+using namespace std;
+
+enum KernelLevel {SCALAR_KERNEL, SSE2_KERNEL, AVX2_KERNEL};
+
+// The approximate density of HeuristicStrategy from the free runs of each row and column.
+// A free run of length R holds R - L + 1 placements of a ship of length L, so a free position
+// counts a ship once for each side with at least L free positions (itself included) in its run.
+// The SIMD versions keep a row per 16 byte lane and build the runs up with shifted masks.
+// The best level the CPU supports is picked the first time it's used (compile with
+// -DBATTLESHIP_NO_SIMD to only keep the scalar one).
+class DensityKernel {
+    public:
+        static void calculate(Bitboard freePos, const int shipLengths[], int numShips, int density[10][10]) {
+            calculate(getLevel(), freePos, shipLengths, numShips, density);
+        }
+        static void calculate(KernelLevel level, Bitboard freePos, const int shipLengths[], int numShips,
+                              int density[10][10]);
+        static KernelLevel getLevel();
+        static bool isSupported(KernelLevel level);
+        static string getLevelName(KernelLevel level);
+};
+
+#endif
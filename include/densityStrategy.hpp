@@ -0,0 +1,57 @@
+#ifndef DENSITYSTRATEGY_HPP
+#define DENSITYSTRATEGY_HPP
+
+#include "targetingStrategy.hpp"
+#include "endgameSolver.hpp"
+
+// Shared parts of the strategies that shoot the most likely position: a probability per
+// position and the parity of each position.
+// Ties go to positions with even parity (spaced by the smallest unsunk ship).
+// With an EndgameSolver, the last few fleets are solved exactly instead.
+class DensityStrategy : public TargetingStrategy {
+    public:
+        void recordShot(int x, int y, ShotResult result, int shipId);
+        void setEndgameSolver(EndgameSolver* endgame) { this->endgame = endgame; } // nullptr turns it off.
+    protected:
+        Board* board;
+        EndgameSolver* endgame = nullptr;
+        int probBoard[10][10];
+        bool parityOutdated; // True if the parity needs setting (new game, or a ship sank).
+        int numLiveShips[Fleet::maxLength + 1]; // Unsunk ships of each length.
+        int minShipSize; // Length of the smallest unsunk ship.
+        Bitboard parity; // Positions with even parity for the smallest unsunk ship.
+        int tieBreaks[100]; // The low byte of each position's move key (see getMoveKey).
+
+        // Methods.
+        void resetDensity(Board &board);
+        void recordSunk(int shipId);
+        Coordinate chooseDensityMove(const int density[100]);
+        bool chooseEndgameMove(Coordinate &move) { return endgame && endgame->chooseMove(board->getTargetView(), move); }
+        void setParityBoard();
+        // Orders the positions by probability, then positions with parity (the last one first),
+        // then the rest (the first one first), so the best move is the highest key.
+        long long getMoveKey(int probability, int cell, bool isHit) {
+            long long key = ((long long)probability << 8) | tieBreaks[cell];
+            return isHit ? -1 : key;
+        }
+        static Coordinate getKeyMove(long long key);
+        bool checkParity(int x, int y) { return parity.test(x, y); }
+        static bool checkParity(int x, int y, int minShipSize) { return parityMasks[minShipSize].test(x, y); }
+        int getMinShipSize() { return minShipSize; }
+
+        static constexpr Bitboard getParityMask(int minShipSize);
+        static const Bitboard parityMasks[Fleet::maxLength + 1];
+};
+
+// The positions where x + y + 1 is a multiple of the smallest ship's size (every ship covers one).
+constexpr Bitboard DensityStrategy::getParityMask(int minShipSize) {
+    Bitboard positions;
+    for (int cell = 0; minShipSize > 0 && cell < 100; cell++) {
+        if (((cell % 10) + (cell / 10) + 1) % minShipSize == 0) {
+            positions = positions | Bitboard::cell(cell);
+        }
+    }
+    return positions;
+}
+
+#endif
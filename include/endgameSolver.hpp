@@ -0,0 +1,84 @@
+#ifndef ENDGAMESOLVER_HPP
+#define ENDGAMESOLVER_HPP
+
+#include "board.hpp"
+#include "coordinate.hpp"
+#include <vector>
+using namespace std;
+
+// Plays the end of a game exactly. Once only a few fleets (placements of every unsunk ship that
+// agree with the shots so far) are left, it lists them all and shoots the position with the fewest
+// expected shots to win, counting every fleet as equally likely.
+// Solved positions go in a transposition table, keyed by a hash of the unsunk ships, the misses and
+// each ship's hits.
+// A position's answer only depends on those, so the table is kept from one game to the next, and
+// the same position always gets the same answer (whether or not it was in the table).
+// It's off by default: it saves about 0.1 shots a game with the approximate density and none with
+// the exact one, for two to three times the time. Its memory (mostly the table) is made when it's
+// first turned on and kept until it's destroyed, so no move allocates.
+class EndgameSolver {
+    public:
+        static const int maxThreshold = 32;
+        static const int defaultThreshold = 0;
+
+        EndgameSolver();
+        ~EndgameSolver();
+        // Starts a new game (the threshold and table are kept).
+        void reset() { clearCandidates(); }
+        // Most fleets it will solve (up to maxThreshold), 0 turns it off. The slowest moves take
+        // several times longer for every 2 more fleets. Turning it on the first time allocates.
+        void setThreshold(int threshold);
+        int getThreshold() { return threshold; }
+
+        // Sets move to the best position, false if there are too many fleets left to solve.
+        bool chooseMove(const TargetView &view, Coordinate &move);
+        int getLastFleetCount() { return numFleets; } // Fleets left at the last move (or threshold + 1).
+        double getLastExpectedShots() { return lastExpectedShots; }
+    private:
+        static const int tableBits = 15; // 512 KB.
+        static const int maxPlacements = PlacementTable<Fleet::minLength>::count;
+        static constexpr double noLimit = 1e9;
+        static constexpr double limitSlack = 1e-4; // More than a float rounds by.
+        // Fleets aren't listed while the product of the ships' placement counts is over this many
+        // times the threshold. The fleets never came within the threshold past that in testing
+        // (the product peaked at 14 with up to 10 fleets), so most moves skip the listing.
+        static const int maxProductRatio = 16;
+
+        // The unsunk ships of one fleet (sunk ships are left empty).
+        struct EndgameFleet {
+            Bitboard ships[Fleet::numShips];
+            Bitboard occupied;
+            unsigned char shipAt[100]; // The ship at each position, numShips for none.
+        };
+        struct TableEntry {
+            uint64_t key; // 0 if empty.
+            float expectedMisses; // Or a lower bound.
+            short bestCell; // -1 for a bound.
+            bool isBound;
+        };
+
+        int threshold;
+        vector<EndgameFleet> fleets; // maxThreshold + 1 once it's been on.
+        int numFleets;
+        double lastExpectedShots;
+        // Placements of each unsunk ship that agree with the shots of the last list.
+        Bitboard listedMisses;
+        Bitboard listedHits[Fleet::numShips];
+        vector<Bitboard> candidates[Fleet::numShips]; // maxPlacements each once it's been on.
+        int numCandidates[Fleet::numShips];
+        int liveShips[Fleet::numShips]; // The unsunk ships, the one with the fewest placements first.
+        int numLiveShips;
+        int liveShipBits; // Bit i for each unsunk ship i.
+        vector<TableEntry> table; // Made when it's first turned on.
+
+        // Methods.
+        void clearCandidates();
+        bool listFleets(const TargetView &view);
+        void addFleets(int depth, Bitboard occupied, EndgameFleet &current);
+        double solve(const unsigned char indices[], int count, double limit, int &bestCell);
+        bool isSameSplit(const unsigned char indices[], int count, int firstCell, int secondCell);
+        uint64_t getKey(const unsigned char indices[], int count, Bitboard &occupied, Bitboard agreedHits[]);
+        double getKnownMisses(const unsigned char indices[], int count);
+};
+
+#endif
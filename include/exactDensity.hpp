@@ -0,0 +1,18 @@
+#ifndef EXACTDENSITY_HPP
+#define EXACTDENSITY_HPP
+
+#include "board.hpp"
+
+// Counts, for every position, the legal placements of the unsunk ships that cover it.
+// Unlike BattleshipCPU::calculateProbability, a placement counts for every position it covers
+// (not just its ends), and a ship that has been hit must cover all of its hits.
+class ExactDensity {
+    public:
+        static const int damagedShipWeight = 100; // Finishing off a hit ship comes first.
+        static void calculate(const TargetView &view, int density[100]);
+    private:
+        template <int ShipId>
+        static void addShipDensity(const TargetView &view, Bitboard allHits, int density[100]);
+};
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef EXACTSTRATEGY_HPP
+#define EXACTSTRATEGY_HPP
+
+#include "densityStrategy.hpp"
+
+// Shoots the position covered by the most legal placements (see ExactDensity), recounted
+// every turn. A hit ship's placements are weighted up, so it also sinks what it finds.
+class ExactStrategy : public DensityStrategy {
+    public:
+        void reset(Board &board) { resetDensity(board); }
+        Coordinate chooseMove();
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef FASTRANDOM_HPP
+#define FASTRANDOM_HPP
+
+#include <cstdint>
+
+// Small seedable random number generator (xoshiro256**), one per user instead of the global rand().
+class FastRandom {
+    public:
+        FastRandom(uint64_t seed = 1) { setSeed(seed); }
+
+        // Expands the seed with splitmix64, so similar seeds give unrelated sequences.
+        void setSeed(uint64_t seed) {
+            for (int i = 0; i < 4; i++) {
+                seed += 0x9E3779B97F4A7C15ULL;
+                uint64_t z = seed;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                state[i] = z ^ (z >> 31);
+            }
+        }
+
+        uint64_t next() {
+            uint64_t result = rotate(state[1] * 5, 7) * 9;
+            uint64_t t = state[1] << 17;
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = rotate(state[3], 45);
+            return result;
+        }
+
+        // Returns a number from 0 to bound - 1 (multiply and shift, the bias is negligible for small bounds).
+        uint32_t nextBelow(uint32_t bound) {
+            return uint32_t(((next() >> 32) * bound) >> 32);
+        }
+
+        // Returns a number from 0 to 1 (exclusive).
+        double nextDouble() {
+            return (next() >> 11) * (1.0 / 9007199254740992.0);
+        }
+    private:
+        uint64_t state[4];
+
+        static uint64_t rotate(uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); }
+};
+
+#endif
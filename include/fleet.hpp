@@ -0,0 +1,81 @@
+#ifndef FLEET_HPP
+#define FLEET_HPP
+
+#include "bitboard.hpp"
+
+// A ship in the fleet.
+struct ShipSpec {
+    char type; // Board piece.
+    const char* name;
+    int length;
+};
+
+struct Placement;
+
+// The fleet (using ships from Hasbro 2002 version), known at compile time.
+// Ship ids are the index into ships, biggest ship first.
+struct Fleet {
+    static constexpr int numShips = 5;
+    static constexpr ShipSpec ships[numShips] = {
+        {'C', "Carrier", 5},
+        {'B', "Battleship", 4},
+        {'D', "Destroyer", 3},
+        {'S', "Submarine", 3},
+        {'P', "Patrol Boat", 2}
+    };
+    static constexpr int minLength = 2;
+    static constexpr int maxLength = 5;
+
+    static constexpr int getLength(int shipId) { return ships[shipId].length; }
+
+    // Every placement of a ship length (2 to 5), see PlacementTable.
+    static const Placement* getPlacements(int length, int &count);
+    // Index of a ship's mask in its length's placements (-1 if it isn't a placement).
+    static int getPlacementIndex(Bitboard mask);
+};
+
+// A ship placement: its positions and how to walk through them.
+struct Placement {
+    Bitboard mask;
+    int start = 0; // Top or left end.
+    int step = 0; // 1 if horizontal, 10 if vertical.
+};
+
+// Every placement of a ship length, horizontal ones first, built at compile time.
+template <int Length>
+struct PlacementTable {
+    static constexpr int numHorizontal = 10 * (11 - Length);
+    static constexpr int count = 2 * numHorizontal;
+    Placement placements[count];
+
+    // Index of the placement starting at start (step is 1 if horizontal, 10 if vertical).
+    static constexpr int getIndex(int start, int step) {
+        return (step == 1) ? ((start / 10) * (11 - Length)) + (start % 10) : numHorizontal + start;
+    }
+
+    constexpr PlacementTable() : placements() {
+        int currCount = 0;
+        for (int step = 1; step <= 10; step += 9) {
+            for (int start = 0; start < 100; start++) {
+                // The whole ship has to stay on the board.
+                int x = start % 10;
+                int y = start / 10;
+                if ((step == 1 && x + Length > 10) || (step == 10 && y + Length > 10)) {
+                    continue;
+                }
+
+                Placement &currPlacement = placements[currCount++];
+                currPlacement.start = start;
+                currPlacement.step = step;
+                for (int k = 0; k < Length; k++) {
+                    currPlacement.mask = currPlacement.mask | Bitboard::cell(start + (k * step));
+                }
+            }
+        }
+    }
+};
+
+template <int Length>
+inline constexpr PlacementTable<Length> placementTable{};
+
+#endif
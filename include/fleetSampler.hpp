@@ -0,0 +1,86 @@
+#ifndef FLEETSAMPLER_HPP
+#define FLEETSAMPLER_HPP
+
+#include "board.hpp"
+#include "fastRandom.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Estimates how likely each position is to hold a ship by sampling whole fleets.
+// Every sample agrees with the shots so far: it avoids the misses, covers each ship's hits
+// and leaves exactly the reported ships sunk. Sampling runs on several threads (each with its
+// own seeded generator, the extra threads are kept until reset) and stops early once the leading
+// position has settled, or optionally once a time budget runs out.
+// With one thread and no latency budget (the default), the estimate only depends on the seed
+// (and nothing is allocated).
+class FleetSampler {
+    public:
+        FleetSampler();
+        ~FleetSampler();
+        void reset(); // Default settings (the seed is kept).
+        void setNumThreads(int numThreads) { this->numThreads = (numThreads > 0) ? numThreads : 1; }
+        void setSeed(uint64_t seed) { this->seed = seed; turn = 0; } // Also restarts the turn count.
+        void setLatencyBudget(double milliseconds) { latencyBudget = milliseconds; } // 0 (the default) means no time limit.
+        void setMaxSamples(int maxSamples) { this->maxSamples = maxSamples; }
+        void setTolerance(double tolerance) { this->tolerance = tolerance; }
+        int getLastSampleCount() { return lastSampleCount; }
+
+        // Fills occupancy with the share of samples with a ship on each position (0 if already shot).
+        void estimate(const TargetView &view, double occupancy[100]);
+    private:
+        static const int batchSize = 128; // Samples drawn by a thread between convergence checks.
+        static const int maxAttempts = 1000; // Tries per sample before giving up on it.
+
+        int numThreads;
+        uint64_t seed;
+        uint64_t turn; // Keeps each turn's generators different.
+        double latencyBudget;
+        int maxSamples;
+        double tolerance; // Stop once the leading position's standard error is below this.
+        int lastSampleCount;
+
+        // Legal placements of an unsunk ship.
+        struct ShipOptions {
+            Bitboard placements[PlacementTable<Fleet::minLength>::count];
+            int count;
+        };
+        ShipOptions options[Fleet::numShips];
+        int order[Fleet::numShips]; // Options to draw from, most constrained ship first.
+        int numOptions;
+
+        // One turn's tallies, shared by the threads and merged after every batch.
+        struct SampleTurn {
+            Bitboard shots;
+            Bitboard sunkShips;
+            chrono::steady_clock::time_point deadline;
+            mutex tallyLock;
+            long long counts[100] = {0};
+            long long numSamples = 0;
+            int prevLeader = -1;
+            atomic<bool> isDone{false};
+        };
+
+        // The extra sampling threads, woken once per turn.
+        vector<thread> workers;
+        mutex poolLock;
+        condition_variable poolWake;
+        condition_variable poolDone;
+        uint64_t jobNumber; // Counts the turns handed to the workers.
+        int numBusyWorkers;
+        SampleTurn* currentTurn;
+        bool isStopping;
+
+        // Methods.
+        bool drawSample(Bitboard sunkShips, FastRandom &random, Bitboard &fleet) const;
+        void sampleBatches(int threadId, SampleTurn &sampleTurn);
+        void startWorkers();
+        void stopWorkers();
+        void workerLoop(int threadId, uint64_t lastJob);
+};
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef GAMEARCHIVE_HPP
+#define GAMEARCHIVE_HPP
+
+#include "battleship.hpp"
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Binary archive of finished games, written as a stream of records after a short header.
+// A record is the seed (8 bytes), the winner, the number of boards, then for each board:
+//   5 placement indices (the fleet), 5 sunk shots (the shot that sank each ship),
+//   the number of shots and one byte per shot (the position, plus hitFlag if it hit).
+// Board 0 is Player 1's board (shot by Player 2 or the CPU), board 1 is Player 2's.
+
+// One board of a game.
+struct BoardRecord {
+    unsigned char fleet[Fleet::numShips];
+    unsigned char sunkAt[Fleet::numShips];
+    unsigned char numShots;
+    unsigned char shots[100];
+};
+
+// A whole game, before it's encoded.
+struct GameRecord {
+    uint64_t seed;
+    unsigned char winner; // 0 if no one won, 1 or 2 for the winning player, 3 if it's a draw.
+    unsigned char numBoards;
+    BoardRecord boards[2];
+};
+
+class GameArchive {
+    public:
+        static const unsigned char hitFlag = 0x80;
+        static const unsigned char noShot = 0xFF; // Sunk shot of a ship that didn't sink.
+        static const int maxRecordSize = 10 + (2 * (11 + 100));
+        static const char magic[4];
+        static const unsigned char version = 1;
+
+        static GameRecord makeRecord(Battleship &game);
+        static int encode(const GameRecord &record, unsigned char* out); // Returns the size in bytes.
+};
+
+// Appends records to an archive file (thread safe).
+class ArchiveWriter {
+    public:
+        ArchiveWriter();
+        ~ArchiveWriter();
+        void open(string fileName); // Throws runtime_error if the file can't be written.
+        void write(const GameRecord &record);
+        void writeEncoded(const unsigned char* data, size_t size); // One or more encoded records.
+        long long getNumRecords() { return numRecords; }
+    private:
+        ofstream archiveFile;
+        mutex writeLock;
+        long long numRecords;
+        vector<char> buffer;
+};
+
+// A record inside a mapped archive (nothing is copied).
+class GameView {
+    public:
+        uint64_t getSeed() const;
+        int getWinner() const { return data[8]; }
+        int getNumBoards() const { return data[9]; }
+        int getFleetIndex(int board, int shipId) const { return boardData[board][shipId]; }
+        Bitboard getShipMask(int board, int shipId) const;
+        int getSunkAt(int board, int shipId) const { return boardData[board][Fleet::numShips + shipId]; }
+        int getNumShots(int board) const { return boardData[board][2 * Fleet::numShips]; }
+        int getShotPos(int board, int index) const { return getShots(board)[index] & ~GameArchive::hitFlag; }
+        bool isShotHit(int board, int index) const { return getShots(board)[index] & GameArchive::hitFlag; }
+        // The board that the winner shot at (or -1).
+        int getLoserBoard() const { return (getWinner() == 1) ? 1 : (getWinner() == 2) ? 0 : -1; }
+    private:
+        friend class ArchiveReader;
+        const unsigned char* data;
+        const unsigned char* boardData[2];
+
+        const unsigned char* getShots(int board) const { return boardData[board] + (2 * Fleet::numShips) + 1; }
+};
+
+// Reads an archive through a memory map.
+class ArchiveReader {
+    public:
+        ArchiveReader();
+        ~ArchiveReader();
+        void open(string fileName); // Throws runtime_error if it can't be read or isn't an archive.
+        void close();
+        bool next(GameView &view); // False at the end (or at a damaged record: cut short, over 100 shots, or a shot off the board).
+        bool isDamaged() { return damaged; }
+        size_t getSize() { return size; }
+    private:
+        const unsigned char* data;
+        size_t size;
+        size_t offset;
+        bool damaged;
+};
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef GAMEPOOL_HPP
+#define GAMEPOOL_HPP
+
+#include "battleshipCpu.hpp"
+#include "objectPool.hpp"
+
+// Reuses games of both kinds: BattleshipCPU for one player, Battleship for two.
+// Not thread safe: use one pool per thread.
+class GamePool {
+    public:
+        GamePool();
+        ~GamePool();
+        Battleship* acquire(int numPlayers); // A reset game (a BattleshipCPU if there's one player).
+        BattleshipCPU* acquireCpu() { return cpuGames.acquire(); }
+        void release(Battleship* game); // Takes back a game from acquire (nullptr is ignored).
+    private:
+        ObjectPool<Battleship> twoPlayerGames;
+        ObjectPool<BattleshipCPU> cpuGames;
+};
+
+#endif
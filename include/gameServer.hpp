@@ -0,0 +1,80 @@
+#ifndef GAMESERVER_HPP
+#define GAMESERVER_HPP
+
+#include "gameSession.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/epoll.h>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Hosts many games at once over a local socket (loopback TCP or a Unix domain socket),
+// speaking GameSession's line protocol.
+// The calling thread accepts connections and hands each one to a worker in turn. Every worker
+// runs its own epoll loop over the sessions it owns, so a game is only ever touched by one thread.
+// Requests can be pipelined: every complete line read is answered, and the answers are written together.
+// A client that doesn't read its answers stops being read from once too many are waiting.
+class GameServer {
+    public:
+        GameServer(int numWorkers);
+        ~GameServer();
+
+        // Throw runtime_error if the socket can't be set up.
+        void listenTcp(int port); // On 127.0.0.1, port 0 picks a free port.
+        void listenUnix(const string &path);
+        int getPort() { return port; }
+
+        void run(); // Serves until stop() is called.
+        void stop(); // Safe to call from a signal handler or another thread.
+        long long getSessions() { return numSessions; }
+        long long getRequests() { return numRequests; }
+    private:
+        static const int maxLineLength = 1024; // Longer requests close the connection.
+        static const size_t maxOutputLength = 64 * 1024; // Unwritten responses before reading pauses.
+        static const int maxEvents = 64;
+        static const int acceptPauseMillis = 100; // Accepting waits this long when out of descriptors.
+
+        // A client connection and its game.
+        struct Connection {
+            Connection(int fd, GamePool &pool) : fd(fd), session(pool) { }
+            int fd;
+            GameSession session;
+            string input; // Bytes read, up to the next newline.
+            string output; // Responses not written yet.
+            uint32_t events = EPOLLIN; // What the worker's epoll waits for.
+            bool isClosing = false; // Close once the output is written.
+        };
+
+        struct Worker {
+            int epollFd = -1;
+            int wakeFd = -1; // Signalled when new connections are handed over.
+            mutex lock;
+            vector<Connection*> newConnections;
+            vector<Connection*> connections; // Owned by the worker's thread.
+            GamePool games; // Only used by the worker's thread.
+            thread loop;
+        };
+
+        int numWorkers;
+        int listenFd;
+        int stopFd; // Readable once the server should stop (every epoll loop waits on it).
+        int port;
+        string unixPath;
+        atomic<long long> numSessions;
+        atomic<long long> numRequests;
+        vector<unique_ptr<Worker>> workers;
+
+        // Methods.
+        void startListening(int fd);
+        bool acceptConnections(int &nextWorker);
+        void workerLoop(Worker &worker);
+        void addNewConnections(Worker &worker);
+        bool readRequests(Connection &connection);
+        bool writeResponses(Worker &worker, Connection &connection);
+        void closeConnection(Worker &worker, Connection* connection);
+};
+
+#endif
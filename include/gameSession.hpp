@@ -0,0 +1,43 @@
+#ifndef GAMESESSION_HPP
+#define GAMESESSION_HPP
+
+#include "gamePool.hpp"
+#include <string>
+using namespace std;
+
+// One client's game, driven by a line protocol (one request line, one response line).
+//   NEW players [seed|random] [engine] [endgameThreshold]
+//                                       Starts a game with random ships -> OK (the threshold turns on
+//                                       the CPU's EndgameSolver, 0 by default)
+//   BOARD player layout                 Replaces a player's ships (100 pieces, row by row) before the
+//                                       first shot -> OK
+//   SHOOT A1                            The current player shoots. Against the CPU it shoots back:
+//                                       -> OK result [cpuCoordinate cpuResult] [WIN 1|2|DRAW]
+//                                       where a result is MISS, HIT type or SUNK type (e.g. SUNK C).
+//   STATE                               -> OK currPlayer PLAYING|WIN 1|2|DRAW p1Board p2Board
+//                                       (boards as 100 pieces, hiding what the players can't see)
+//   METRICS [GAME]                      -> OK json, the server's metrics (of finished games) or the
+//                                       current game's (see Metrics::writeJson)
+//   QUIT                                -> OK, then the connection is closed.
+// Anything else gets ERR message, and leaves the game as it was.
+class GameSession {
+    public:
+        GameSession(GamePool &pool); // Games come from the pool, and go back to it.
+        ~GameSession();
+
+        // Handles a request line (without the newline). Returns false if the session should close.
+        bool handle(const string &request, string &response);
+    private:
+        GamePool &pool;
+        Battleship* game;
+        bool hasShots; // Boards can only be replaced before the first shot.
+
+        // Methods.
+        void newGame(int numPlayers, bool isSeeded, uint64_t seed, DensityEngine engine, int endgameThreshold);
+        void shoot(const string &coordinate, string &response);
+        void addState(string &response);
+        void addStatus(string &response);
+        static void addLastShot(Board &board, string &response);
+};
+
+#endif
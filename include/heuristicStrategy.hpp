@@ -0,0 +1,50 @@
+#ifndef HEURISTICSTRATEGY_HPP
+#define HEURISTICSTRATEGY_HPP
+
+#include "densityStrategy.hpp"
+#include "moveQueue.hpp"
+
+// The CPU's original strategy. Hunts with an approximate density (the ends of the free
+// placements of each unsunk ship, recounted before each hunt move), then sinks a hit ship with
+// queued moves: first around the hit to find its direction, then along it.
+class HeuristicStrategy : public DensityStrategy {
+    public:
+        void reset(Board &board);
+        Coordinate chooseMove();
+        void recordShot(int x, int y, ShotResult result, int shipId);
+    protected:
+        int liveShipLengths[Fleet::numShips]; // Lengths of the unsunk ships.
+        int numLiveShips;
+        bool densityOutdated; // True if there has been a shot since the density was calculated.
+        bool sinkMode; // True, if it's currently sinking a found ship.
+        int prevShipHit; // Id of the ship being sunk.
+        // Target mode, indexed by ship id.
+        MoveQueue shipPosFound[Fleet::numShips]; // Discovered ship positions.
+        bool isShipFound[Fleet::numShips];
+        MoveQueue cpuMoves[Fleet::numShips]; // Moves to sink the ship(s) found.
+        bool hasCpuMoves[Fleet::numShips];
+        int numShipsWithMoves;
+        // Every queued move plus a refill for each ship, more than getCpuMove can ever check.
+        static const int maxMoveChecks = Fleet::numShips * (MoveQueue::capacity + 2);
+
+        // Methods.
+        void calculateProbability();
+        Coordinate getNextMove(); // Get move based on probability density.
+        Coordinate getCpuMove();
+        void setCpuMoves(int x, int y, int shipId);
+        void findShip(int x, int y, int shipId);
+        void sinkShip(int x, int y, int shipId);
+
+        void backTrackShot(int x, int y);
+        void setAltMoves(Direction dir, Coordinate prevShipMove);
+        void pushMoveIfValid(MoveQueue &moves, int x, int y);
+        void setPrevShip();
+        MoveQueue& getCpuMoves(int shipId);
+        void clearShipMoves(int shipId);
+        static int getFirstShip(const bool shipFlags[Fleet::numShips]);
+        static Coordinate toCoordinate(int cell) { return Coordinate(cell % 10, cell / 10); }
+        Direction getDirection(Coordinate first, Coordinate last);
+        bool canShipExist(int shipLength, Coordinate currPos, Direction dir);
+};
+
+#endif
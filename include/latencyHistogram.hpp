@@ -0,0 +1,81 @@
+#ifndef LATENCYHISTOGRAM_HPP
+#define LATENCYHISTOGRAM_HPP
+
+#include <cstdint>
+
+// Fixed-size histogram of durations in nanoseconds, for percentiles without keeping every sample.
+// Values under 16 get their own bucket, larger ones share a bucket with values within 1/8 of them.
+class LatencyHistogram {
+    public:
+        static const int numBuckets = 16 + (60 * 8);
+
+        LatencyHistogram() { clear(); }
+        void clear() {
+            for (int i = 0; i < numBuckets; i++) {
+                buckets[i] = 0;
+            }
+            count = 0;
+            total = 0;
+            maxValue = 0;
+        }
+
+        void add(uint64_t nanoseconds) {
+            buckets[getBucket(nanoseconds)]++;
+            count++;
+            total += nanoseconds;
+            maxValue = (nanoseconds > maxValue) ? nanoseconds : maxValue;
+        }
+
+        void merge(const LatencyHistogram &other) {
+            for (int i = 0; i < numBuckets; i++) {
+                buckets[i] += other.buckets[i];
+            }
+            count += other.count;
+            total += other.total;
+            maxValue = (other.maxValue > maxValue) ? other.maxValue : maxValue;
+        }
+
+        long long getCount() const { return count; }
+        uint64_t getMax() const { return maxValue; }
+        double getMean() const { return (count > 0) ? double(total) / count : 0; } // Exact, not from the buckets.
+
+        // Upper end of the bucket holding the given percentile (0 to 100), never more than the max.
+        uint64_t getPercentile(double percentile) const {
+            long long rank = (long long)((percentile / 100) * count);
+            rank = (rank < count) ? rank : count - 1;
+            long long seen = 0;
+            for (int i = 0; i < numBuckets; i++) {
+                seen += buckets[i];
+                if (seen > rank) {
+                    uint64_t upper = getBucketEnd(i);
+                    return (upper < maxValue) ? upper : maxValue;
+                }
+            }
+            return maxValue;
+        }
+    private:
+        long long buckets[numBuckets];
+        long long count;
+        uint64_t total;
+        uint64_t maxValue;
+
+        static int getBucket(uint64_t value) {
+            if (value < 16) {
+                return int(value);
+            }
+            int exponent = 63 - __builtin_clzll(value); // At least 4.
+            int fraction = int((value >> (exponent - 3)) & 7);
+            return 16 + ((exponent - 4) * 8) + fraction;
+        }
+
+        static uint64_t getBucketEnd(int bucket) {
+            if (bucket < 16) {
+                return uint64_t(bucket);
+            }
+            int exponent = ((bucket - 16) / 8) + 4;
+            uint64_t fraction = (bucket - 16) % 8;
+            return ((8 + fraction + 1) << (exponent - 3)) - 1;
+        }
+};
+
+#endif
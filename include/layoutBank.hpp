@@ -0,0 +1,46 @@
+#ifndef LAYOUTBANK_HPP
+#define LAYOUTBANK_HPP
+
+#include "layoutValidator.hpp"
+#include "fastRandom.hpp"
+#include <string>
+#include <vector>
+using namespace std;
+
+// A fleet layout and how many shots the CPU needed to find it on average.
+struct BankLayout {
+    ShipLayout fleet;
+    double score;
+};
+
+// Ranked fleet layouts (best first) that are hard to find, made offline by PlacementOptimizer.
+// A game draws one of them, turned by one of the board's 8 symmetries (a rotation and/or a
+// reflection, which the CPU finds just as hard). The turned copies are made on load, so a draw
+// only copies five masks. Saved as text, one layout per line:
+//   <score> <the 100 board pieces, row by row>
+class LayoutBank {
+    public:
+        static const int numSymmetries = 8;
+
+        LayoutBank();
+        ~LayoutBank();
+        void add(const ShipLayout &fleet, double score); // Kept in rank order.
+        bool empty() const { return layouts.empty(); }
+        int size() const { return layouts.size(); }
+        const BankLayout& getLayout(int rank) const { return layouts[rank]; }
+        // Places a random layout of the bank on an empty board.
+        void draw(FastRandom &random, Board &board) const;
+
+        // False if the file can't be opened, throws runtime_error if a layout is invalid.
+        bool load(string fileName);
+        void save(string fileName) const; // Throws runtime_error if it can't be written.
+
+        static string getLayoutText(const ShipLayout &fleet); // The 100 board pieces, row by row.
+        static ShipLayout transform(const ShipLayout &fleet, int symmetry);
+        static int transformCell(int cell, int symmetry);
+    private:
+        vector<BankLayout> layouts;
+        vector<ShipLayout> variants; // Every layout under every symmetry (in the order they were added).
+};
+
+#endif
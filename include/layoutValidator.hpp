@@ -0,0 +1,36 @@
+#ifndef LAYOUTVALIDATOR_HPP
+#define LAYOUTVALIDATOR_HPP
+
+#include "board.hpp"
+#include <cstddef>
+#include <string>
+using namespace std;
+
+enum LayoutError {
+    LAYOUT_OK,
+    LAYOUT_MISSING_SHIP,
+    LAYOUT_OFF_BOARD,
+    LAYOUT_WRONG_LENGTH, // Too few or too many positions (a repeated ship has too many).
+    LAYOUT_NOT_STRAIGHT, // Bent, split or wrapping onto another row.
+    LAYOUT_OVERLAP
+};
+
+// A fleet as one mask per ship (in fleet order).
+struct ShipLayout {
+    Bitboard ships[Fleet::numShips];
+};
+
+// Checks fleets from their ship masks: a ship is valid if its mask is exactly one of its placements.
+// Each ship is a popcount, a lowest bit and two shifted comparisons, with nothing allocated.
+class LayoutValidator {
+    public:
+        static LayoutError validateShip(Bitboard mask, int shipId);
+        // The first invalid ship is put in shipId (-1 if every ship is valid).
+        static LayoutError validate(const Bitboard ships[Fleet::numShips], int &shipId);
+        static LayoutError validate(Board &board);
+        // Fills errors with the result of each layout and returns how many are valid.
+        static size_t validateBatch(const ShipLayout* layouts, size_t count, LayoutError* errors);
+        static string getMessage(LayoutError error);
+};
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+using namespace std;
+
+// Counters and timers for the hot paths of a game. Compile with -DBATTLESHIP_NO_METRICS to remove
+// them: the METRIC_ macros become empty, and the exports show zeros with "enabled" false.
+// The code being measured doesn't know which game it's in: cpuShoot, shoot and showBoard make
+// their game's metrics current for the thread (METRIC_SCOPE), and the counters go there.
+enum MetricCounter {
+    PROBABILITY_PASSES, // Densities calculated from scratch.
+    PROBABILITY_CELLS, // Unshot positions the density passes counted.
+    PARITY_REBUILDS, // Parities set (a new game, or a ship sank).
+    CPU_MOVE_CALLS, // Target mode moves asked for.
+    CPU_MOVE_RETRIES, // Stale queued moves skipped.
+    CPU_MOVE_REFILLS, // Empty queues refilled from a ship's hits.
+    CPU_MOVE_FALLBACKS, // Target mode gave up and used the density.
+    CPU_MOVES_QUEUED, // Queued moves (over every ship) at each target mode call.
+    NUM_METRIC_COUNTERS
+};
+enum MetricMaximum {
+    CPU_MOVE_MAX_DEPTH, // Most checks getCpuMove needed for one move.
+    CPU_MOVE_MAX_QUEUED, // Most moves queued at once.
+    NUM_METRIC_MAXIMA
+};
+enum MetricTimerId {
+    CPU_TURN_TIME,
+    SHOOT_TIME,
+    SHOW_BOARD_TIME,
+    NUM_METRIC_TIMERS
+};
+
+struct MetricTimer {
+    uint64_t count;
+    uint64_t totalNanoseconds;
+    uint64_t maxNanoseconds;
+};
+
+// Everything measured in one game (or merged from many).
+struct GameMetrics {
+    uint64_t counters[NUM_METRIC_COUNTERS];
+    uint64_t maxima[NUM_METRIC_MAXIMA];
+    MetricTimer timers[NUM_METRIC_TIMERS];
+
+    GameMetrics() { clear(); }
+    void clear();
+    void merge(const GameMetrics &other);
+};
+
+class Metrics {
+    public:
+        static const bool isEnabled;
+
+        // The game being measured on this thread (nullptr outside a game, where nothing is counted).
+        inline static thread_local GameMetrics* current = nullptr;
+
+        static void add(MetricCounter counter, uint64_t amount) {
+            if (current) {
+                current->counters[counter] += amount;
+            }
+        }
+        static void setMax(MetricMaximum maximum, uint64_t value) {
+            if (current && value > current->maxima[maximum]) {
+                current->maxima[maximum] = value;
+            }
+        }
+        static void addTime(MetricTimerId timer, uint64_t nanoseconds);
+
+        // Every game's metrics are added to the process's once it's done with (reset or destroyed).
+        static void addToProcess(const GameMetrics &metrics);
+        static GameMetrics getProcessMetrics();
+
+        // One line of JSON, e.g. {"enabled":true,"game":3,"counters":{...},"maxima":{...},"timers":{...}}.
+        // A negative game leaves it out (for the process's metrics).
+        static void writeJson(ostream &out, const GameMetrics &metrics, long long game = -1);
+        // Prometheus text format, the labels (e.g. scope="process") are added to every sample.
+        static void writePrometheus(ostream &out, const GameMetrics &metrics, const string &labels);
+        static string getCounterName(MetricCounter counter);
+        static string getMaximumName(MetricMaximum maximum);
+        static string getTimerName(MetricTimerId timer);
+};
+
+// Makes a game's metrics current until the end of the block.
+class MetricsScope {
+    public:
+        MetricsScope(GameMetrics &metrics) { prev = Metrics::current; Metrics::current = &metrics; }
+        ~MetricsScope() { Metrics::current = prev; }
+    private:
+        GameMetrics* prev;
+};
+
+// Times the rest of the block.
+class MetricsTimerScope {
+    public:
+        MetricsTimerScope(MetricTimerId timer) { this->timer = timer; start = chrono::steady_clock::now(); }
+        ~MetricsTimerScope() {
+            Metrics::addTime(timer, chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+        }
+    private:
+        MetricTimerId timer;
+        chrono::steady_clock::time_point start;
+};
+
+#ifndef BATTLESHIP_NO_METRICS
+#define METRIC_ADD(counter, amount) Metrics::add(counter, amount)
+#define METRIC_MAX(maximum, value) Metrics::setMax(maximum, value)
+#define METRIC_SCOPE(metrics) MetricsScope metricsScope(metrics)
+#define METRIC_TIMER(timer) MetricsTimerScope metricsTimer(timer)
+#else
+#define METRIC_ADD(counter, amount)
+#define METRIC_MAX(maximum, value)
+#define METRIC_SCOPE(metrics)
+#define METRIC_TIMER(timer)
+#endif
+
+#endif
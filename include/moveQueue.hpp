@@ -0,0 +1,32 @@
+#ifndef MOVEQUEUE_HPP
+#define MOVEQUEUE_HPP
+
+// Fixed-capacity queue of board positions (y * 10 + x), so the CPU's target mode never allocates.
+// A full queue ignores new positions (a ship never needs more than a handful queued).
+class MoveQueue {
+    public:
+        static const int capacity = 16;
+
+        MoveQueue() { clear(); }
+        void clear() { first = 0; count = 0; }
+        bool empty() const { return count == 0; }
+        int size() const { return count; }
+        int front() const { return cells[first]; }
+        int back() const { return cells[(first + count - 1) % capacity]; }
+        void push(int cell) {
+            if (count < capacity) {
+                cells[(first + count) % capacity] = cell;
+                count++;
+            }
+        }
+        void pop() {
+            first = (first + 1) % capacity;
+            count--;
+        }
+    private:
+        unsigned char cells[capacity];
+        int first;
+        int count;
+};
+
+#endif
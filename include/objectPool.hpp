@@ -0,0 +1,56 @@
+#ifndef OBJECTPOOL_HPP
+#define OBJECTPOOL_HPP
+
+#include <vector>
+using namespace std;
+
+// Keeps finished objects to be reused, instead of deleting them and making new ones.
+// T needs a reset() that puts it back to a newly constructed state without allocating.
+// Not thread safe: use one pool per thread.
+template <class T>
+class ObjectPool {
+    public:
+        ObjectPool(int numObjects = 0) {
+            numCreated = 0;
+            freeObjects.reserve(numObjects);
+            for (int i = 0; i < numObjects; i++) {
+                freeObjects.push_back(new T());
+                numCreated++;
+            }
+        }
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool& operator=(const ObjectPool&) = delete;
+
+        // Deconstructor deletes the free objects (objects still in use belong to their users).
+        ~ObjectPool() {
+            for (T* object : freeObjects) {
+                delete object;
+            }
+        }
+
+        // Returns a reset object, only making a new one if none are free.
+        T* acquire() {
+            if (freeObjects.empty()) {
+                numCreated++;
+                return new T();
+            }
+            T* object = freeObjects.back();
+            freeObjects.pop_back();
+            object->reset();
+            return object;
+        }
+
+        void release(T* object) {
+            if (object) {
+                freeObjects.push_back(object);
+            }
+        }
+
+        int getNumCreated() { return numCreated; }
+        int getNumFree() { return int(freeObjects.size()); }
+    private:
+        vector<T*> freeObjects;
+        int numCreated;
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef PLACEMENTOPTIMIZER_HPP
+#define PLACEMENTOPTIMIZER_HPP
+
+#include "layoutBank.hpp"
+#include "simulator.hpp"
+#include <map>
+#include <ostream>
+using namespace std;
+
+// Searches for fleet layouts that take the CPU many shots to find, by simulated annealing.
+// A layout's score is the average shots the CPU needed against it, over every engine and every
+// symmetry of the layout (the engines break ties the same way, so a turned layout is a new game).
+// The games are played across the threads by Simulator. Each restart anneals from a random fleet,
+// moving one ship at a time: usually nearby (a short shift or a turn), otherwise anywhere free.
+class PlacementOptimizer {
+    public:
+        PlacementOptimizer(int numThreads);
+        ~PlacementOptimizer();
+        void addEngine(DensityEngine engine);
+        void setSeed(uint64_t seed) { this->seed = seed; random.setSeed(seed); }
+        void setIterations(int iterations) { this->iterations = (iterations > 1) ? iterations : 2; }
+        void setRestarts(int restarts) { this->restarts = restarts; }
+        void setGamesPerVariant(int games) { gamesPerVariant = (games > 0) ? games : 1; } // More only helps random engines.
+        void setTemperature(double start, double end) { startTemperature = start; endTemperature = end; } // In shots.
+        double score(const ShipLayout &fleet);
+        // Anneals, then puts the best distinct layouts found in the bank (a symmetry isn't distinct).
+        void run(LayoutBank &bank, int bankSize, ostream* progress);
+    private:
+        static const int localDistance = 2; // How far a nearby move can shift a ship's start.
+        int numThreads;
+        uint64_t seed;
+        FastRandom random;
+        vector<DensityEngine> engines;
+        int iterations;
+        int restarts;
+        int gamesPerVariant;
+        double startTemperature;
+        double endTemperature;
+        map<string, BankLayout> bestLayouts; // By their first symmetry in text order.
+
+        // Methods.
+        ShipLayout getRandomLayout();
+        ShipLayout getNeighbour(const ShipLayout &fleet);
+        void keepLayout(const ShipLayout &fleet, double score, int bankSize);
+        static string getCanonicalText(const ShipLayout &fleet);
+};
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef RANDOMSTRATEGY_HPP
+#define RANDOMSTRATEGY_HPP
+
+#include "targetingStrategy.hpp"
+#include "fastRandom.hpp"
+
+// Baseline: shoots a random position that hasn't been shot.
+class RandomStrategy : public TargetingStrategy {
+    public:
+        RandomStrategy() { board = nullptr; }
+        void reset(Board &board) { this->board = &board; }
+        void setSeed(uint64_t seed) { random.setSeed(seed); }
+        Coordinate chooseMove();
+        void recordShot(int x, int y, ShotResult result, int shipId) { }
+    protected:
+        Board* board;
+        FastRandom random;
+};
+
+#endif
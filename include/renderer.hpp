@@ -0,0 +1,53 @@
+#ifndef RENDERER_HPP
+#define RENDERER_HPP
+
+#include "board.hpp"
+using namespace std;
+
+// How much a game writes to the terminal.
+// QUIET_OUTPUT: nothing (headless simulations, replays and benchmarks).
+// TEXT_OUTPUT: the per-shot messages, but no boards.
+// FULL_OUTPUT: the messages and a frame of both boards whenever they are shown.
+enum OutputLevel {QUIET_OUTPUT, TEXT_OUTPUT, FULL_OUTPUT};
+
+// Draws both boards. Each frame is built in one preallocated buffer and written with a single
+// write() call. On an ANSI terminal the boards stay at the top of the screen (the rest scrolls
+// below them) and later frames only redraw the positions that changed.
+class Renderer {
+    public:
+        Renderer();
+        ~Renderer();
+        void setAnsi(bool status) { isAnsi = status; hasPrevFrame = false; }
+        bool getAnsi() { return isAnsi; }
+        void reset() { hasPrevFrame = false; } // The next frame is drawn in full.
+        void render(Board &p1Board, Board &p2Board, int numPlayers);
+        int getLastFrameSize() { return frameSize; } // Bytes written for the last frame.
+
+        static bool isAnsiTerminal();
+    private:
+        static const int frameCapacity = 4096; // A full frame is under 1KB, a diff of every position under 2KB.
+        static const int boardRow = 4; // Screen row of the first board row (below the blank line and the header).
+        static const int p1Column = 6; // Screen column of the first position of each board.
+        static const int p2Column = 36;
+        static const int scrollRow = 14; // First screen row below the boards.
+
+        char frame[frameCapacity];
+        int frameSize;
+        char cells[2][100]; // What each position shows, for both boards.
+        char prevCells[2][100];
+        int prevNumPlayers;
+        bool hasPrevFrame;
+        bool isAnsi;
+        bool hasScrollRegion;
+
+        // Methods.
+        void setCells(Board &p1Board, Board &p2Board, int numPlayers);
+        void addFullFrame(int numPlayers);
+        void addChangedCells();
+        void append(const char* text);
+        void append(char piece) { frame[frameSize++] = piece; }
+        void appendNumber(int number);
+        void writeFrame();
+};
+
+#endif
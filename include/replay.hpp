@@ -0,0 +1,40 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include "battleshipCpu.hpp"
+#include <string>
+#include <vector>
+using namespace std;
+
+// A CPU game that can be played again exactly: the seed, the CPU's settings, Player 1's fleet and
+// the CPU's shots. Saved as text:
+//   seed 12345
+//   engine approximate
+//   endgame 0 (the endgame threshold, see EndgameSolver; 0 if it's missing)
+//   layout <the 100 board pieces, row by row>
+//   moves 44 45 ... (positions shot, y * 10 + x)
+class Replay {
+    public:
+        uint64_t seed;
+        DensityEngine engine;
+        int endgameThreshold;
+        string layout;
+        vector<int> moves;
+
+        Replay();
+        ~Replay();
+
+        // Sets up a seeded headless game, so its moves only depend on the seed and the layout.
+        static void setUpGame(BattleshipCPU &game, uint64_t seed, DensityEngine engine, const string &layout,
+                              int endgameThreshold = 0);
+        // Plays a game and records it (an empty layout places the ships from the seed).
+        static Replay record(uint64_t seed, DensityEngine engine, const string &layout, int endgameThreshold = 0);
+        // Plays the game again, returns the first move that differs (or -1 if every move matches).
+        int verify() const;
+
+        // Throws runtime_error if the file can't be written or read.
+        void save(string fileName) const;
+        static Replay load(string fileName);
+};
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef SAMPLINGSTRATEGY_HPP
+#define SAMPLINGSTRATEGY_HPP
+
+#include "densityStrategy.hpp"
+#include "fleetSampler.hpp"
+
+// Shoots the position most often covered by whole fleets sampled to fit every shot (see FleetSampler).
+class SamplingStrategy : public DensityStrategy {
+    public:
+        void reset(Board &board) { resetDensity(board); } // The sampler keeps its settings.
+        void setSeed(uint64_t seed) { sampler.setSeed(seed); }
+        Coordinate chooseMove();
+        FleetSampler& getSampler() { return sampler; }
+    protected:
+        FleetSampler sampler;
+};
+
+#endif
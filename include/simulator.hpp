@@ -0,0 +1,63 @@
+#ifndef SIMULATOR_HPP
+#define SIMULATOR_HPP
+
+#include "battleshipCpu.hpp"
+#include "gameArchive.hpp"
+#include "latencyHistogram.hpp"
+#include "objectPool.hpp"
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Results of a batch of headless games.
+struct SimulationResult {
+    long long games = 0;
+    double seconds = 0;
+    vector<long long> shotHistogram; // Index is the number of shots the CPU needed to win.
+    vector<long long> threadGames;
+    vector<double> threadSeconds; // Time each thread spent playing games.
+    vector<long long> threadSteals;
+    long long worstGame = -1; // The game that needed the most shots (the first one, if tied).
+    int worstShots = 0;
+    LatencyHistogram turnLatency; // Time of each CPU turn.
+    vector<unsigned char> gameShots; // Shots each game needed, from the first game of the run.
+};
+
+// Plays BattleshipCPU against many fleets without any terminal I/O.
+class Simulator {
+    public:
+        Simulator(int numThreads);
+        ~Simulator();
+        void addCorpusBoard(string fileName);
+        void addCorpusLayout(const string &layout) { corpus.push_back(layout); } // 100 pieces, row by row.
+        // Alternates random fleets (even games) with the corpus (odd games), instead of only the corpus.
+        void setMixedFleets(bool isMixed) { this->isMixed = isMixed; }
+        void setDensityEngine(DensityEngine engine) { densityEngine = engine; }
+        void setEndgameThreshold(int threshold) { endgameThreshold = threshold; } // See EndgameSolver, 0 (the default) is off.
+        void setSeed(uint64_t seed) { this->seed = seed; }
+        void setArchive(ArchiveWriter* archive) { this->archive = archive; } // Every game is written to it.
+        void setMetricsLog(ostream* metricsLog) { this->metricsLog = metricsLog; } // A JSON line per game.
+        uint64_t getGameSeed(long long game);
+        const string& getGameLayout(long long game); // Empty if the game uses a random fleet.
+        SimulationResult run(long long numGames, long long firstGame = 0); // Games firstGame onwards.
+        static void printReport(const SimulationResult &result, ostream &out);
+    private:
+        static const int gamesPerTask = 64;
+        int numThreads;
+        DensityEngine densityEngine;
+        int endgameThreshold;
+        uint64_t seed; // Every game's seed comes from this, so a run can be repeated.
+        ArchiveWriter* archive;
+        ostream* metricsLog;
+        mutex metricsLock;
+        vector<string> corpus; // Board layouts, used in turn instead of random fleets.
+        bool isMixed;
+
+        // Methods.
+        int playGame(long long gameIndex, BattleshipCPU &game, vector<unsigned char> &records,
+                     LatencyHistogram &turnLatency);
+};
+
+#endif
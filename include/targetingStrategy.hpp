@@ -0,0 +1,24 @@
+#ifndef TARGETINGSTRATEGY_HPP
+#define TARGETINGSTRATEGY_HPP
+
+#include "board.hpp"
+#include "coordinate.hpp"
+#include <cstdint>
+
+// How the CPU picks its shots, so strategies can be swapped at runtime (see BattleshipCPU).
+// There are only two virtual calls a turn: the per-position work happens inside each
+// strategy's own (non-virtual) methods, where nothing is dispatched.
+class TargetingStrategy {
+    public:
+        virtual ~TargetingStrategy() { }
+        // Starts a new game against the board (the strategy reads it until the next reset).
+        // Only what a player is told is used: the shots, which ship was hit and which ships sank.
+        virtual void reset(Board &board) = 0;
+        virtual void setSeed(uint64_t seed) { }
+        // The next position to shoot, (-1, -1) only if every position has been shot.
+        virtual Coordinate chooseMove() = 0;
+        // What the shot at (x, y) hit (shipId is -1 on a miss).
+        virtual void recordShot(int x, int y, ShotResult result, int shipId) = 0;
+};
+
+#endif
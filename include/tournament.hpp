@@ -0,0 +1,75 @@
+#ifndef TOURNAMENT_HPP
+#define TOURNAMENT_HPP
+
+#include "simulator.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// A CPU configuration in the tournament and its results so far.
+struct TournamentEntry {
+    DensityEngine engine;
+    int endgameThreshold; // See EndgameSolver, 0 is off.
+    vector<unsigned char> gameShots; // Shots to win of each game played, by game index.
+    LatencyHistogram turnLatency; // Time of each decision.
+    bool isActive; // False once every comparison it's in is settled.
+};
+
+enum Verdict {VERDICT_UNDECIDED, VERDICT_FIRST_BETTER, VERDICT_SECOND_BETTER, VERDICT_EQUIVALENT};
+
+// Two entries compared on the games both have played (the same fleets, so the shots are paired).
+struct TournamentComparison {
+    int first;
+    int second;
+    long long games;
+    double meanDifference; // First's shots minus second's, negative if first needs fewer.
+    double halfWidth; // Of the confidence interval for the difference, at the corrected level.
+    Verdict verdict;
+};
+
+// Plays every configuration against the same seeded fleets (random fleets and an optional corpus),
+// a round at a time, until each pair of configurations is settled or the game limit is reached.
+// Paired differences in shots to win are checked after every round. Each check uses alpha divided
+// by the number of pairs and the number of possible rounds (Bonferroni), so stopping as soon as a
+// pair is settled still keeps the chance of any wrong verdict under alpha.
+// A pair is settled when its interval excludes zero (one is better) or fits inside the margin (equivalent).
+class Tournament {
+    public:
+        Tournament(int numThreads);
+        ~Tournament();
+        void addEngine(DensityEngine engine, int endgameThreshold = 0);
+        void addCorpusLayout(const string &layout) { corpus.push_back(layout); }
+        void setSeed(uint64_t seed) { this->seed = seed; }
+        void setRoundGames(long long roundGames) { this->roundGames = (roundGames > 1) ? roundGames : 2; }
+        void setMaxGames(long long maxGames) { this->maxGames = maxGames; }
+        void setAlpha(double alpha) { this->alpha = alpha; }
+        void setMargin(double margin) { this->margin = margin; } // Shots, for equivalence.
+        // Plays rounds until everything is settled, writing a line per round to progress (if given).
+        void run(ostream* progress);
+        void printReport(ostream &out);
+        const vector<TournamentEntry>& getEntries() { return entries; }
+        const vector<TournamentComparison>& getComparisons() { return comparisons; }
+        static double getCriticalValue(double alpha); // Two-sided standard normal quantile.
+    private:
+        int numThreads;
+        uint64_t seed;
+        long long roundGames;
+        long long maxGames;
+        double alpha;
+        double margin;
+        double criticalValue; // For the corrected alpha.
+        vector<string> corpus;
+        vector<TournamentEntry> entries;
+        vector<TournamentComparison> comparisons;
+
+        // Methods.
+        void playRound(TournamentEntry &entry);
+        void compare(TournamentComparison &comparison);
+        void updateActive();
+        static void getMeanInterval(const vector<unsigned char> &shots, double &mean, double &halfWidth);
+        static string getEntryName(const TournamentEntry &entry); // The engine, and the threshold if it's on.
+        static string getVerdictText(const TournamentComparison &comparison, const vector<TournamentEntry> &entries);
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef WORKSTEALINGPOOL_HPP
+#define WORKSTEALINGPOOL_HPP
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+using namespace std;
+
+// Runs a batch of tasks across a fixed number of threads.
+// Each thread works through its own queue, then steals from the back of the others.
+class WorkStealingPool {
+    public:
+        WorkStealingPool(int numThreads);
+        ~WorkStealingPool();
+        void submit(function<void(int)> task); // The task receives the worker's id.
+        void run(); // Blocks until every submitted task has finished.
+        int getNumThreads() { return numThreads; }
+        long long getSteals(int workerId) { return queues[workerId]->steals; }
+    private:
+        struct WorkerQueue {
+            mutex lock;
+            deque<function<void(int)>> tasks;
+            long long steals = 0;
+        };
+
+        int numThreads;
+        int nextQueue; // Round robin position for submit().
+        atomic<long long> pendingTasks;
+        vector<unique_ptr<WorkerQueue>> queues;
+
+        // Methods.
+        void workerLoop(int workerId);
+        bool popTask(int workerId, function<void(int)> &task);
+        bool stealTask(int workerId, function<void(int)> &task);
+};
+
+#endif
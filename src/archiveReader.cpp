@@ -0,0 +1,106 @@
+#include "../include/gameArchive.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+// The reader is kept apart from the records and the writer: it maps the file, so only the
+// tools use it (the game only writes archives).
+
+ArchiveReader::ArchiveReader() {
+    data = nullptr;
+    size = 0;
+    offset = 0;
+    damaged = false;
+}
+
+// Deconstructor unmaps the archive.
+ArchiveReader::~ArchiveReader() {
+    close();
+}
+
+void ArchiveReader::open(string fileName) {
+    close();
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw runtime_error("The archive '" + fileName + "' cannot be found.");
+    }
+
+    struct stat buffer;
+    fstat(fd, &buffer);
+    size = buffer.st_size;
+    void* mapped = (size > 0) ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        size = 0;
+        throw runtime_error("The archive '" + fileName + "' cannot be read.");
+    }
+    data = (const unsigned char*) mapped;
+    madvise(mapped, size, MADV_SEQUENTIAL);
+
+    if (size < 5 || memcmp(data, GameArchive::magic, 4) != 0 || data[4] != GameArchive::version) {
+        close();
+        throw runtime_error("'" + fileName + "' isn't a game archive.");
+    }
+    offset = 5;
+    damaged = false;
+}
+
+void ArchiveReader::close() {
+    if (data) {
+        munmap((void*) data, size);
+    }
+    data = nullptr;
+    size = 0;
+    offset = 0;
+}
+
+// Points the view at the next record.
+bool ArchiveReader::next(GameView &view) {
+    if (offset + 10 > size) {
+        damaged = offset != size;
+        return false;
+    }
+
+    const unsigned char* record = data + offset;
+    size_t recordSize = 10;
+    int numBoards = record[9];
+    if (numBoards < 1 || numBoards > 2) {
+        damaged = true;
+        return false;
+    }
+    for (int i = 0; i < numBoards; i++) {
+        // The shot count has to be inside the file.
+        if (offset + recordSize + (2 * Fleet::numShips) >= size) {
+            damaged = true;
+            return false;
+        }
+        view.boardData[i] = record + recordSize;
+        int numShots = record[recordSize + (2 * Fleet::numShips)];
+        if (numShots > 100) {
+            damaged = true;
+            return false;
+        }
+        recordSize += (2 * Fleet::numShips) + 1 + numShots;
+    }
+    if (offset + recordSize > size) {
+        damaged = true;
+        return false;
+    }
+    // Readers index the board by the shot positions.
+    for (int i = 0; i < numBoards; i++) {
+        for (int j = 0; j < view.getNumShots(i); j++) {
+            if (view.getShotPos(i, j) >= 100) {
+                damaged = true;
+                return false;
+            }
+        }
+    }
+
+    view.data = record;
+    offset += recordSize;
+    return true;
+}
@@ -0,0 +1,234 @@
+#include "../include/batchDriver.hpp"
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+using namespace std;
+
+BatchDriver::BatchDriver() {
+    numPlayers = 1;
+    isSeeded = false;
+    seed = 0;
+    engine = APPROXIMATE_DENSITY;
+    outputLevel = QUIET_OUTPUT;
+}
+
+// Deconstructor.
+BatchDriver::~BatchDriver() { }
+
+string BatchDriver::readScript(const string &fileName) {
+    stringstream contents;
+    if (fileName == "-") {
+        contents << cin.rdbuf();
+        return contents.str();
+    }
+
+    ifstream scriptFile(fileName);
+    if (!scriptFile.is_open()) {
+        throw runtime_error("The script '" + fileName + "' cannot be read.");
+    }
+    contents << scriptFile.rdbuf();
+    return contents.str();
+}
+
+void BatchDriver::run(const string &script, ostream &out) {
+    istringstream lines(script);
+    string line;
+    int lineNum = 0;
+    auto start = chrono::steady_clock::now();
+
+    while (getline(lines, line)) {
+        lineNum++;
+        // Drop comments.
+        size_t commentPos = line.find('#');
+        if (commentPos != string::npos) {
+            line.erase(commentPos);
+        }
+        istringstream words(line);
+        string command;
+        if (!(words >> command)) {
+            continue;
+        }
+        string lineError = "Script line " + to_string(lineNum) + ", ";
+
+        if (command == "players") {
+            if (!(words >> numPlayers) || numPlayers < 1 || numPlayers > 2) {
+                throw runtime_error(lineError + "the number of players must be 1 or 2.");
+            }
+        } else if (command == "board") {
+            int player;
+            string fileName;
+            if (!(words >> player) || player < 1 || player > 2) {
+                throw runtime_error(lineError + "the board's player must be 1 or 2.");
+            }
+            // The rest of the line is the file name (board files can have spaces).
+            getline(words >> ws, fileName);
+            while (!fileName.empty() && isspace(fileName.back())) {
+                fileName.pop_back();
+            }
+            if (fileName.empty()) {
+                throw runtime_error(lineError + "no board file given.");
+            }
+            boardFiles[player - 1] = (fileName == "-") ? "" : fileName;
+        } else if (command == "seed") {
+            string value;
+            words >> value;
+            if (value == "random") {
+                isSeeded = false;
+            } else {
+                try {
+                    seed = stoull(value);
+                    isSeeded = true;
+                } catch (logic_error &e) {
+                    throw runtime_error(lineError + "the seed must be a number or random.");
+                }
+            }
+        } else if (command == "engine") {
+            string name;
+            words >> name;
+            if (!BattleshipCPU::getEngine(name, engine)) {
+                throw runtime_error(lineError + "unknown engine '" + name + "'.");
+            }
+        } else if (command == "output") {
+            string level;
+            words >> level;
+            if (level == "quiet") {
+                outputLevel = QUIET_OUTPUT;
+            } else if (level == "text") {
+                outputLevel = TEXT_OUTPUT;
+            } else if (level == "full") {
+                outputLevel = FULL_OUTPUT;
+            } else {
+                throw runtime_error(lineError + "the output must be quiet, text or full.");
+            }
+        } else if (command == "shots") {
+            string shot;
+            while (words >> shot) {
+                shots.push_back(shot);
+            }
+        } else if (command == "play") {
+            string count;
+            long long repeats = (words >> count) ? atoll(count.c_str()) : 1;
+            if (repeats < 1) {
+                throw runtime_error(lineError + "the number of games must be at least 1.");
+            }
+            for (long long i = 0; i < repeats; i++) {
+                BatchGameResult result = playGame(seed + i);
+                printResult(result, out);
+                results.push_back(result);
+            }
+            seed += isSeeded ? repeats : 0;
+            shots.clear();
+        } else {
+            throw runtime_error(lineError + "unknown command '" + command + "'.");
+        }
+    }
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    printSummary(out);
+    out << "Total time: " << fixed << setprecision(3) << seconds << "s" << endl;
+}
+
+// Plays one game with the current settings, the same way as the interactive driver.
+BatchGameResult BatchDriver::playGame(uint64_t gameSeed) {
+    BatchGameResult result;
+    result.numPlayers = numPlayers;
+    auto start = chrono::steady_clock::now();
+
+    Battleship* game = games.acquire(numPlayers);
+    if (numPlayers == 1) {
+        static_cast<BattleshipCPU*>(game)->setDensityEngine(engine);
+    }
+    game->setOutputLevel(outputLevel);
+    if (isSeeded) {
+        game->setSeed(gameSeed);
+    }
+
+    try {
+        game->setBoardFile(1, boardFiles[0]);
+        game->setBoardFile(2, boardFiles[1]);
+        game->startGame(numPlayers, !boardFiles[0].empty(), !boardFiles[1].empty());
+    } catch (runtime_error &e) {
+        result.error = e.what();
+        games.release(game);
+        return result;
+    }
+
+    // Take the shots until someone wins (both players shoot before the game is checked).
+    int nextShot = 0;
+    while (!game->isP1Win() && !game->isP2Win() && nextShot < int(shots.size())) {
+        for (int currPlayer = 1; currPlayer <= numPlayers && nextShot < int(shots.size()); currPlayer++) {
+            game->showBoard();
+            try {
+                char x;
+                int y;
+                Battleship::parseCoordinate(shots[nextShot++], x, y);
+                game->shoot(x, y);
+                result.turns += (currPlayer == 1) ? 1 : 0;
+                if (numPlayers == 1) {
+                    static_cast<BattleshipCPU*>(game)->cpuShoot();
+                }
+            } catch (logic_error &e) {
+                result.rejectedShots++;
+                currPlayer--; // The same player shoots again.
+            }
+        }
+    }
+    game->showBoard();
+
+    if (game->isP1Win() && game->isP2Win()) {
+        result.winner = 3;
+    } else if (game->isP1Win()) {
+        result.winner = 1;
+    } else if (game->isP2Win()) {
+        result.winner = 2;
+    }
+    games.release(game);
+
+    result.micros = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+void BatchDriver::printResult(const BatchGameResult &result, ostream &out) {
+    out << "Game " << results.size() + 1 << ": ";
+    if (!result.error.empty()) {
+        out << "Error: " << result.error << endl;
+        return;
+    }
+
+    const char* outcomes[] = {"unfinished", "Player 1 wins", "Player 2 wins", "draw"};
+    const char* outcome = (result.numPlayers == 1 && result.winner == 2) ? "CPU wins" : outcomes[result.winner];
+    out << result.numPlayers << ((result.numPlayers == 1) ? " player, " : " players, ") << result.turns << " turns, " << outcome;
+    if (result.rejectedShots > 0) {
+        out << ", " << result.rejectedShots << " rejected shots";
+    }
+    out << ", " << fixed << setprecision(1) << result.micros << " us" << endl;
+}
+
+// Game counts and timings (games that couldn't start aren't timed).
+void BatchDriver::printSummary(ostream &out) {
+    long long numPlayed = 0;
+    long long numFinished = 0;
+    double totalMicros = 0;
+    double maxMicros = 0;
+    for (const BatchGameResult &result : results) {
+        if (!result.error.empty()) {
+            continue;
+        }
+        numPlayed++;
+        numFinished += (result.winner != 0) ? 1 : 0;
+        totalMicros += result.micros;
+        maxMicros = (result.micros > maxMicros) ? result.micros : maxMicros;
+    }
+
+    out << "Games: " << results.size() << " (" << numFinished << " finished, "
+        << results.size() - numPlayed << " failed to start)" << endl;
+    if (numPlayed > 0) {
+        out << "Time per game: " << fixed << setprecision(1) << totalMicros / numPlayed << " us average, "
+            << maxMicros << " us max" << endl;
+    }
+}
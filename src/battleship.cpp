@@ -1,35 +1,80 @@
 #include "../include/battleship.hpp"
+#include "../include/layoutValidator.hpp"
+#include "../include/layoutBank.hpp"
 #include <iostream>
+#include <cctype>
 #include <fstream>
 #include <sys/stat.h>
 #include <exception>
-#include <cstdlib>
-#include <ctime>
+#include <random>
 using namespace std;
 
 Battleship::Battleship() {
     // cout << "Battleship object made." << endl;
+    seed = random_device()();
+    random.setSeed(seed);
+    Battleship::reset();
 }
 
-// Deconstructor deletes/clears certain data structures.
+// Deconstructor.
 Battleship::~Battleship() {
     // cout << "Battleship object destroyed." << endl;
-    for (int i = 0; i < 10; i++) {
-        delete[] p1Board[i];
-        delete[] p2Board[i];
-    }
-    delete[] p1Board;
-    delete[] p2Board;
+    Metrics::addToProcess(metrics);
+}
 
-    p1Ships = {};
-    p2Ships = {};
+// Sets everything the constructor does, apart from the random generator (so a reused
+// object doesn't repeat its last game). Nothing is allocated.
+// The last game's metrics are added to the process's.
+void Battleship::reset() {
+    Metrics::addToProcess(metrics);
+    metrics.clear();
+    outputLevel = FULL_OUTPUT;
+    renderer.reset();
+    p1BoardFile = "P1 Board.txt";
+    p2BoardFile = "P2 Board.txt";
+    layoutBank = nullptr;
+    initBoards(1);
 }
 
 // Initialises the game components and fills the board.
 void Battleship::startGame(int numPlayers, bool loadP1ShipFile, bool loadP2ShipFile) {
-    p1Board = new char* [10];
-    p2Board = new char* [10];
+    initBoards(numPlayers);
+
+    // Set the ship placements for Player 1.
+    if (loadP1ShipFile) {
+        getShipsFromFile(p1BoardFile, p1Board);
+    } else {
+        placeShips(p1Board);
+    }
+
+    // Set ship placements for Player 2 (the CPU's fleet can come from the layout bank).
+    if (loadP2ShipFile) {
+        getShipsFromFile(p2BoardFile, p2Board);
+    } else if (numPlayers == 1 && layoutBank && !layoutBank->empty()) {
+        layoutBank->draw(random, p2Board);
+    } else {
+        placeShips(p2Board);
+    }
+}
 
+// Initialises a CPU only game against Player 1's board (no one shoots at the CPU).
+// The layout holds the 100 board pieces row by row, an empty layout places the ships randomly.
+void Battleship::startSimulation(const string &p1Layout) {
+    initBoards(1);
+
+    if (p1Layout.empty()) {
+        placeShips(p1Board);
+    } else {
+        for (int i = 0; i < 10; i++) {
+            for (int j = 0; j < 10; j++) {
+                p1Board.setPiece(j, i, p1Layout[(i * 10) + j]);
+            }
+        }
+    }
+}
+
+// Clears the boards and resets the game status.
+void Battleship::initBoards(int numPlayers) {
     this->numPlayers = numPlayers;
     currPlayer = 1; // Whose turn it is.
     p1ShipCount = 5;
@@ -37,40 +82,60 @@ void Battleship::startGame(int numPlayers, bool loadP1ShipFile, bool loadP2ShipF
     isFinished = false;
     p1Win = false;
     p2Win = false;
-
-    for (int i = 0; i < 10; i++) {
-        p1Board[i] = new char[10];
-        p2Board[i] = new char[10];
-        for (int j = 0; j < 10; j++) {
-            p1Board[i][j] = emptySpace;
-            p2Board[i][j] = emptySpace;
-        }
-    }
-
-    // Placing the seed here ensures that both boards are random.
-    srand(time(NULL));
+    p1Board.clear();
+    p2Board.clear();
 
     // Set data for the ships.
     setShipData(p1Ships);
     setShipData(p2Ships);
+}
 
-    // Set the ship placements for Player 1.
-    if (loadP1ShipFile) {
-        getShipsFromFile("P1 Board.txt", p1Board);
+// Sets the file (in the boards folder) used when a player loads their ships.
+void Battleship::setBoardFile(int player, string fileName) {
+    if (player == 1) {
+        p1BoardFile = fileName;
     } else {
-        placeShips(p1Board);
+        p2BoardFile = fileName;
     }
+}
 
-    // Set ship placements for Player 2.
-    if (loadP2ShipFile) {
-        getShipsFromFile("P2 Board.txt", p2Board);
-    } else {
-        placeShips(p2Board);
+// Returns the 100 pieces of a player's board, row by row.
+string Battleship::getBoardLayout(int player) {
+    Board &currBoard = (player == 1) ? p1Board : p2Board;
+    string layout;
+    for (int i = 0; i < 10; i++) {
+        for (int j = 0; j < 10; j++) {
+            layout += currBoard.getPiece(j, i);
+        }
+    }
+    return layout;
+}
+
+// Replaces a player's ships with a layout of 100 board pieces, row by row (before any shots).
+void Battleship::setBoardLayout(int player, const string &layout) {
+    if (layout.length() != 100) {
+        throw runtime_error("The layout must have 100 pieces.");
+    }
+    for (char piece : layout) {
+        if (piece != emptySpace && Board::getShipId(piece) < 0) {
+            throw runtime_error(string("Invalid piece '") + piece + "' in the layout.");
+        }
+    }
+
+    Board newBoard;
+    for (int i = 0; i < 10; i++) {
+        for (int j = 0; j < 10; j++) {
+            newBoard.setPiece(j, i, layout[(i * 10) + j]);
+        }
+    }
+    if (!isShipPlacementValid(newBoard)) {
+        throw runtime_error("Incorrect ship placements.");
     }
+    ((player == 1) ? p1Board : p2Board) = newBoard;
 }
 
 // Reads the ships from the specified file.
-void Battleship::getShipsFromFile(string fileName, char** currBoard) {
+void Battleship::getShipsFromFile(string fileName, Board &currBoard) {
     const string boardDir = "../boards/" + fileName;
     ifstream boardFile(boardDir);
 
@@ -91,7 +156,7 @@ void Battleship::getShipsFromFile(string fileName, char** currBoard) {
     
     while (getline(boardFile, row)) {
         // Insert pieces from each row.
-        for (int i = 0; i < row.length(); i++) {
+        for (int i = 0; i < int(row.length()); i++) {
             // Each piece is seperated by a whitespace.
             switch (row[i]) {
                 case 'C':
@@ -99,7 +164,7 @@ void Battleship::getShipsFromFile(string fileName, char** currBoard) {
                 case 'D':
                 case 'S':
                 case 'P':
-                    currBoard[rowNum][colNum] = row[i];
+                    currBoard.setPiece(colNum, rowNum, row[i]);
                     colNum++;
                     break;
                 case emptySpace:
@@ -151,319 +216,152 @@ void Battleship::getShipsFromFile(string fileName, char** currBoard) {
 }
 
 // Check if the board contents are valid (from a file).
-bool Battleship::isShipPlacementValid(char** board) {
-    // Holds previously visited positions.
-    unordered_map<char, vector<Coordinate>> visitedPos;
-
-    // Go through the board.
-    for (int i = 0; i < 10; i++) {
-        for (int j = 0; j < 10; j++) {
-            int shipLength;
-            switch (board[i][j]) {
-                // Set the ship length.
-                case 'C':
-                    shipLength = 5;
-                    break;
-                case 'B':
-                    shipLength = 4;
-                    break;
-                case 'D':
-                case 'S':
-                    shipLength = 3;
-                    break;
-                case 'P':
-                    shipLength = 2;
-                    break;
-                // Ignore empty spaces.
-                case emptySpace:
-                    continue;
-                    break;
-                // The piece is invalid (it shouldn't reach here...).
-                default:
-                    return false;
-            }
-
-            char shipType = board[i][j];
-
-            // Add a position queue for a ship (if it doesn't exist).
-            if (visitedPos.find(shipType) == visitedPos.end()) {
-                vector<Coordinate> newShipPos(1, Coordinate(j, i));
-                visitedPos[shipType] = newShipPos;
-                // Check if the ship has been placed correctly.
-                // NOTE: the remainder of the ship's positions will be added to the vector.
-                if (!isShipValid(board, visitedPos[shipType], shipType, shipLength)) {
-                    return false;
-                }
-            } else {
-                bool isShipSame = false;
-                vector<Coordinate> existShipPos = visitedPos[shipType];
-                // Check if it's a piece of an existing ship.
-                for (Coordinate pos : existShipPos) {
-                    if ((pos.getY() == i) && (pos.getX() == j)) {
-                        isShipSame = true;
-                        break;
-                    }
-                }
-
-                // If it isn't, then the user has placed two of the same ship...
-                if (!isShipSame) {
-                    return false;
-                }
-            }
-        }
-    }
-
-    // If there are not enough ships.
-    if (visitedPos.size() != 5) {
-        return false;
-    }
-
-    // The whole board is valid.
-    return true;
-}
-
-// Checks if a placement for a ship is valid.
-bool Battleship::isShipValid(char** board, vector<Coordinate> &shipPos, char shipType, int shipLength) {
-    Coordinate foundPos = shipPos.front();
-    int currSize = 1;
-
-    // Check if it's placed vertically.
-    for (int i = 1; i < shipLength; i++) {
-        // Check downwards (the board is checked left to right, top to bottom).
-        int downPos = foundPos.getY() + i;
-        if (downPos <= 9 && board[downPos][foundPos.getX()] == shipType) {
-            shipPos.push_back(Coordinate(foundPos.getX(), downPos));
-            currSize++;
-        } else {
-            break;
-        }
-    }
-    if (currSize == shipLength) {
-        return true;
-    }
-
-    // Reset currSize.
-    currSize = 1;
-
-    // Check if it's placed horizontally.
-    for (int i = 1; i < shipLength; i++) {
-        // Check to the right.
-        int rightPos = foundPos.getX() + i;
-        if (rightPos <= 9 && board[foundPos.getY()][rightPos] == shipType) {
-            shipPos.push_back(Coordinate(rightPos, foundPos.getY()));
-            currSize++;
-        } else {
-            break;
-        }
-    }
-    if (currSize == shipLength) {
-        return true;
-    }
-
-    // Incorrect ship size.
-    return false;
+bool Battleship::isShipPlacementValid(Board &board) {
+    return LayoutValidator::validate(board) == LAYOUT_OK;
 }
 
 // Sets the information for each ship.
-void Battleship::setShipData(unordered_map<char, Ship> &ships) {
-    for (int i = 2; i <= 5; i++) {
-        switch (i) {
-            case 5:
-                ships['C'] = {"Carrier", i, i};
-                break;
-            case 4:
-                ships['B'] = {"Battleship", i, i};
-                break;
-            case 3:
-                ships['D'] = {"Destroyer", i, i};
-                ships['S'] = {"Submarine", i, i};
-                break;
-            case 2:
-                ships['P'] = {"Patrol Boat", i, i};
-                break;
-        }
+void Battleship::setShipData(Ship ships[]) {
+    for (int i = 0; i < Fleet::numShips; i++) {
+        ships[i] = Ship(Fleet::ships[i].name, Fleet::ships[i].length, Fleet::ships[i].length);
     }
 }
 
 // Places the ships randomly on the board.
-void Battleship::placeShips(char** board) {
+void Battleship::placeShips(Board &board) {
     // Place the bigger ships first.
-    for (int i = 5; i > 0; i--) {
-        int x = rand() % 10;
-        int y = rand() % 10;
-
-        // If an existing position is selected.
-        if (board[y][x] != emptySpace) {
-            i++;
-            continue;
-        }
-
-        // Set the ship type (using ships from Hasbro 2002 version).
-        char shipType;
-        int shipLength = i;
-        switch (i) {
-            case 5:
-                shipType = 'C';
-                break;
-            case 4:
-                shipType = 'B';
-                break;
-            case 3:
-                shipType = 'D';
-                break;
-            case 2:
-                shipType = 'S';
-                shipLength = 3;
-                break;
-            case 1:
-                shipType = 'P';
-                shipLength = 2;
-                break;
-        }
+    placeFleet(board, make_integer_sequence<int, Fleet::numShips>());
+}
 
-        // Stores the possible placements in the co-ordinate.
-        vector<Direction> validDir = getValidDirections(x, y, shipLength, board);
-        
-        // If it's impossible to place the (whole) ship, then try and place it again.
-        if (validDir.size() == 0) {
-            i++;
-            continue;
-        }
+// Places each ship in turn.
+template <int... ShipIds>
+void Battleship::placeFleet(Board &board, integer_sequence<int, ShipIds...>) {
+    (placeShipRandomly<ShipIds>(board), ...);
+}
 
-        // Randomly choose the possible direction.
-        int dirIndex = rand() % validDir.size();
-        Direction placeDir = validDir[dirIndex];
+// Places a ship uniformly at random on one of its placements that only covers free positions.
+// A single draw from the whole table is usually free, and is kept if it is. Otherwise the legal
+// placements are found with bit operations and one of them is drawn. Each legal placement then
+// has a chance of 1/total + (1 - legal/total) / legal = 1/legal, with no retries or allocations.
+template <int ShipId>
+void Battleship::placeShipRandomly(Board &board) {
+    constexpr int shipLength = Fleet::getLength(ShipId);
+    constexpr const PlacementTable<shipLength> &table = placementTable<shipLength>;
+    Bitboard occupied = board.occupied();
+
+    const Placement &firstDraw = table.placements[random.nextBelow(table.count)];
+    if ((firstDraw.mask & occupied).empty()) {
+        board.placeShip(ShipId, firstDraw.mask);
+        return;
+    }
 
-        // Clear up the vector.
-        validDir.clear();
-        validDir.shrink_to_fit();
+    Bitboard freePos = ~occupied & Bitboard::full();
+    Bitboard horizontal = Board::getSegmentStarts<shipLength>(freePos, RIGHT);
+    Bitboard vertical = Board::getSegmentStarts<shipLength>(freePos, DOWN);
+    int numHorizontal = horizontal.count();
 
-        // Place the ships on the board.
-        switch (placeDir) {
-            case UP:
-                for (int j = 0; j < shipLength; j++) {
-                    board[y - j][x] = shipType;
-                }
-                break;
-            case DOWN:
-                for (int j = 0; j < shipLength; j++) {
-                    board[y + j][x] = shipType;
-                }
-                break;
-            case LEFT:
-                for (int j = 0; j < shipLength; j++) {
-                    board[y][x - j] = shipType;
-                }
-                break;
-            case RIGHT:
-                for (int j = 0; j < shipLength; j++) {
-                    board[y][x + j] = shipType;
-                }
-                break;
-        }
+    // Earlier ships cover at most 15 positions, so there's always a legal placement.
+    int choice = random.nextBelow(numHorizontal + vertical.count());
+    int index;
+    if (choice < numHorizontal) {
+        index = table.getIndex(horizontal.select(choice), 1);
+    } else {
+        index = table.getIndex(vertical.select(choice - numHorizontal), 10);
     }
+    board.placeShip(ShipId, table.placements[index].mask);
 }
 
-// Gets the valid placement directions for a ship.
-vector<Direction> Battleship::getValidDirections(int x, int y, int shipLength, char** board) {
-    vector<Direction> validDir;
-    bool upValid = true;
-    bool downValid = true;
-    bool leftValid = true;
-    bool rightValid = true;
-
-    // Try and place the ship in each direction.
-    for (int j = 0; j < shipLength; j++) {
-        // UP
-        if ((y - shipLength < 0) || board[y - j][x] != emptySpace) {
-            upValid = false;
-        }
-        // DOWN
-        if ((y + shipLength > 9) || board[y + j][x] != emptySpace) {
-            downValid = false;
-        }
-        // LEFT
-        if ((x - shipLength < 0) || board[y][x - j] != emptySpace) {
-            leftValid = false;
-        }
-        // RIGHT
-        if ((x + shipLength > 9) || board[y][x + j] != emptySpace) {
-            rightValid = false;
-        }
-        // Exit early if placement is impossible.
-        if (!upValid && !downValid && !leftValid && !rightValid) {
+// Splits co-ordinates such as A1 or j10 into x (A to J) and y (1 to 10).
+void Battleship::parseCoordinate(const string &xy, char &x, int &y) {
+    string strY;
+
+    // Check the length.
+    switch (xy.length()) {
+        // If y is 10.
+        case 3:
+            strY = xy.substr(1,2);
             break;
-        }
+        // If y is between 1 and 9.
+        case 2:
+            strY = xy[1];
+            break;
+        default:
+            throw logic_error("Invalid co-ordinate length.");
     }
 
-    if (upValid) {
-        validDir.push_back(UP);
-    }
-    if (downValid) {
-        validDir.push_back(DOWN);
-    }
-    if (leftValid) {
-        validDir.push_back(LEFT);
+    // Set x here (it's possible to input nothing).
+    x = toupper(xy[0]);
+
+    // Check if x is in range.
+    if (x < 'A' || x > 'J') {
+        throw logic_error("The x-coordinate is out of range. Enter between A and J.");
     }
-    if (rightValid) {
-        validDir.push_back(RIGHT);
+
+    // Check if the y-coordinates are integers.
+    for (char letter : strY) {
+        if (letter < '0' || letter > '9') {
+            throw logic_error("The y-coordinate must be in numbers.");
+        }
     }
 
-    return validDir;
+    // Convert y-coordinates to an integer, then check the range.
+    y = stoi(strY);
+    if (y < 1 || y > 10) {
+        throw logic_error("The y-coordinate is out of range. Enter between 1 and 10.");
+    }
 }
 
 // Takes the player's co-ordinates to perform their turn.
 void Battleship::shoot(char charX, int y) {
+    METRIC_SCOPE(metrics);
+    METRIC_TIMER(SHOOT_TIME);
+
     // Set the current board, ships and ship count.
-    char** currBoard = (currPlayer == 1) ? p2Board : p1Board;
-    unordered_map<char, Ship> &currShips = (currPlayer == 1) ? p2Ships : p1Ships;
+    Board &currBoard = (currPlayer == 1) ? p2Board : p1Board;
+    Ship* currShips = (currPlayer == 1) ? p2Ships : p1Ships;
     int &currShipCount = (currPlayer == 1) ? p2ShipCount : p1ShipCount;
 
     int x = charX - 'A';
     y--; // Decrement y for index use.
 
-    bool shipHit = false;
-    char shipType;
+    int shipId;
 
     // Check what was hit.
-    switch (currBoard[y][x]) {
-        // If a ship is hit.
-        case 'C':
-        case 'B':
-        case 'D':
-        case 'S':
-        case 'P':
-            shipHit = true;
-            shipType = currBoard[y][x];
-            currBoard[y][x] = 'X';
-            break;
-        case emptySpace:
-            currBoard[y][x] = 'O';
-            cout << "Miss." << endl;
+    switch (currBoard.shoot(x, y, shipId)) {
+        case SHOT_MISS:
+            if (outputLevel != QUIET_OUTPUT) {
+                cout << "Miss." << endl;
+            }
             break;
-        default:
-            // The position was already hit.
+        case SHOT_REPEATED:
             throw logic_error("You've hit this position already.");
+        // If a ship is hit.
+        default:
+            break;
     }
 
     // If a ship was hit.
-    if (shipHit) {
+    if (shipId >= 0) {
         // Get the ship that was hit.
-        Ship &thatShip = currShips[shipType];
+        Ship &thatShip = currShips[shipId];
         thatShip.setHealth(thatShip.getHealth() - 1);
 
         // If the resulting hit sunk the ship.
         if (thatShip.getHealth() == 0) {
             currShipCount--;
             // Display a suitable message.
-            cout << "Hit and sunk. " << thatShip.getName() << '.' << endl;
-        } else {
+            if (outputLevel != QUIET_OUTPUT) {
+                cout << "Hit and sunk. " << thatShip.getName() << '.' << endl;
+            }
+        } else if (outputLevel != QUIET_OUTPUT) {
             cout << "Hit. " << thatShip.getName() << '.' << endl;
         }
     }
 
     // Show the number of ships sunk.
-    cout << "Ships Sunk: " << (5 - currShipCount) << endl;
+    if (outputLevel != QUIET_OUTPUT) {
+        cout << "Ships Sunk: " << (5 - currShipCount) << endl;
+    }
 
     // If all the opponent's ships have sunk.
     if (currShipCount == 0) {
@@ -484,60 +382,11 @@ void Battleship::shoot(char charX, int y) {
     }
 }
 
-// Checks if a position has been hit.
-bool Battleship::isPosHit(char boardPiece) {
-    switch (boardPiece) {
-        case 'X':
-        case 'O':
-            return true;
-        default:
-            return false;
-    }
-}
-
-// Show the current contents of the boards.
+// Show the current contents of the boards (only at the full output level).
 void Battleship::showBoard() {
-    switch (numPlayers) {
-        case 2:
-            cout << endl << "P1   A B C D E F G H I J   |  P2   A B C D E F G H I J" << endl;
-            break;
-        case 1:
-            cout << endl << "You  A B C D E F G H I J   |  CPU  A B C D E F G H I J" << endl;
-            break;
+    METRIC_SCOPE(metrics);
+    METRIC_TIMER(SHOW_BOARD_TIME);
+    if (outputLevel == FULL_OUTPUT) {
+        renderer.render(p1Board, p2Board, numPlayers);
     }
-    cout << "   ---------------------   |" << "     ---------------------" << endl;
-
-    for (int i = 0; i < 10; i++) {
-        // Print the line of the first board.
-        for (int j = 0; j < 10; j++) {
-            // Show P1's ships if it's hit or if it's a single player game.
-            char currPiece = ((numPlayers == 1) || isPosHit(p1Board[i][j])) ? p1Board[i][j] : emptySpace;
-            
-            // If it's the start and the 10th row.
-            if (j == 0 && i == 9) {
-                cout << i + 1 << " | " << currPiece << ' ';
-            // Any other starting row.
-            } else if (j == 0) {
-                cout << ' ' << i + 1 << " | " << currPiece << ' ';
-            // All other pieces in the row.
-            } else {
-                cout << currPiece << ' ';
-            }
-        }
-
-        // Print the line of the second board.
-        for (int j = 0; j < 10; j++) {
-            // Hide the opponents ships if they're not hit.
-            char currPiece = isPosHit(p2Board[i][j]) ? p2Board[i][j] : emptySpace;
-            
-            if (j == 0 && i == 9) {
-                cout << "  |  " << i + 1 << " | " << currPiece << ' ';
-            } else if (j == 0) {
-                cout << "  |   " << i + 1 << " | " << currPiece << ' ';
-            } else {
-                cout << currPiece << ' ';
-            }
-        }
-        cout << endl;
-    }
-}
\ No newline at end of file
+}
@@ -0,0 +1,140 @@
+#include "../include/board.hpp"
+
+// Marks positions off the board, so a segment leaving the board is never free.
+static const Bitboard offBoard = ~Bitboard::full();
+
+Board::Board() {
+    clear();
+}
+
+// Deconstructor.
+Board::~Board() { }
+
+// Removes every ship and shot.
+void Board::clear() {
+    for (int i = 0; i < numShips; i++) {
+        ships[i] = Bitboard();
+    }
+    hits = Bitboard();
+    misses = Bitboard();
+    shots = Bitboard();
+    numShots = 0;
+}
+
+// Returns the piece shown for a position: a ship, X (hit), O (miss) or an empty space.
+char Board::getPiece(int x, int y) {
+    if (hits.test(x, y)) {
+        return 'X';
+    }
+    if (misses.test(x, y)) {
+        return 'O';
+    }
+    for (int i = 0; i < numShips; i++) {
+        if (ships[i].test(x, y)) {
+            return getShipType(i);
+        }
+    }
+    return emptySpace;
+}
+
+// Adds a ship piece to the board (anything else is ignored).
+void Board::setPiece(int x, int y, char piece) {
+    int shipId = getShipId(piece);
+    if (shipId >= 0) {
+        ships[shipId].set((y * 10) + x);
+    }
+}
+
+// Converts a ship type into the index of the ship's bitboard.
+int Board::getShipId(char shipType) {
+    for (int i = 0; i < numShips; i++) {
+        if (Fleet::ships[i].type == shipType) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Returns the misses, the hits on each ship and the sunk ships.
+TargetView Board::getTargetView() {
+    TargetView view;
+    view.misses = misses;
+    for (int i = 0; i < numShips; i++) {
+        view.shipHits[i] = ships[i] & hits;
+        view.isSunk[i] = isShipSunk(i);
+    }
+    return view;
+}
+
+// Checks if a ship fits on the board without touching another ship.
+bool Board::canPlaceShip(int x, int y, Direction dir, int shipLength) {
+    return (getSegment(x, y, dir, shipLength) & (occupied() | offBoard)).empty();
+}
+
+// Places a ship (the placement should be checked with canPlaceShip first).
+void Board::placeShip(int shipId, int x, int y, Direction dir, int shipLength) {
+    ships[shipId] |= getSegment(x, y, dir, shipLength);
+}
+
+// Shoots a position, the ship's id is set if a ship was hit.
+ShotResult Board::shoot(int x, int y, int &shipId) {
+    Bitboard target = Bitboard::cell(x, y);
+    shipId = -1;
+
+    if ((shots & target).any()) {
+        return SHOT_REPEATED;
+    }
+    shots |= target;
+    shotOrder[numShots++] = (y * 10) + x;
+
+    for (int i = 0; i < numShips; i++) {
+        if ((ships[i] & target).any()) {
+            hits |= target;
+            shipId = i;
+            return isShipSunk(i) ? SHOT_SUNK : SHOT_HIT;
+        }
+    }
+    misses |= target;
+    return SHOT_MISS;
+}
+
+// Checks if every position of a segment is on the board and hasn't been shot.
+// Shots in ignoredShots don't block the segment.
+bool Board::isSegmentFree(int x, int y, Direction dir, int length, Bitboard ignoredShots) {
+    if (x < 0 || x > 9 || y < 0 || y > 9) {
+        return false;
+    }
+    return (getSegment(x, y, dir, length) & ((shots & ~ignoredShots) | offBoard)).empty();
+}
+
+// Returns the positions covered by a segment, starting at (x, y).
+// A segment that leaves the board includes a position off the board.
+Bitboard Board::getSegment(int x, int y, Direction dir, int length) {
+    // Segments for every length (up to 5), direction and starting position.
+    static const struct SegmentTable {
+        Bitboard segments[6][4][100];
+        SegmentTable() {
+            for (int length = 1; length <= 5; length++) {
+                for (int dir = UP; dir <= RIGHT; dir++) {
+                    for (int cell = 0; cell < 100; cell++) {
+                        int currX = cell % 10;
+                        int currY = cell / 10;
+                        Bitboard segment;
+                        for (int i = 0; i < length; i++) {
+                            if (currX < 0 || currX > 9 || currY < 0 || currY > 9) {
+                                segment |= offBoard;
+                                break;
+                            }
+                            segment |= Bitboard::cell(currX, currY);
+                            currY += (dir == DOWN) - (dir == UP);
+                            currX += (dir == RIGHT) - (dir == LEFT);
+                        }
+                        segments[length][dir][cell] = segment;
+                    }
+                }
+            }
+        }
+    } table;
+
+    return table.segments[length][dir][(y * 10) + x];
+}
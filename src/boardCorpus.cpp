@@ -0,0 +1,262 @@
+#include "../include/boardCorpus.hpp"
+#include "../include/workStealingPool.hpp"
+#include <algorithm>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+BoardCorpus::BoardCorpus(int numThreads) {
+    this->numThreads = (numThreads > 0) ? numThreads : 1;
+}
+
+// Deconstructor.
+BoardCorpus::~BoardCorpus() { }
+
+bool BoardCorpus::loadFile(string path) {
+    struct stat buffer;
+    if (stat(path.c_str(), &buffer) || !S_ISREG(buffer.st_mode)) {
+        errors.push_back({path, 0, PARSE_UNREADABLE, 0, 0, LAYOUT_OK});
+        return false;
+    }
+    parseFiles({path});
+    return true;
+}
+
+bool BoardCorpus::loadDirectory(string path) {
+    DIR* dir = opendir(path.c_str());
+    if (!dir) {
+        errors.push_back({path, 0, PARSE_UNREADABLE, 0, 0, LAYOUT_OK});
+        return false;
+    }
+
+    vector<string> paths;
+    while (dirent* entry = readdir(dir)) {
+        string filePath = path + '/' + entry->d_name;
+        struct stat buffer;
+        if (entry->d_name[0] != '.' && !stat(filePath.c_str(), &buffer) && S_ISREG(buffer.st_mode)) {
+            paths.push_back(filePath);
+        }
+    }
+    closedir(dir);
+
+    sort(paths.begin(), paths.end());
+    parseFiles(paths);
+    return true;
+}
+
+Bitboard BoardCorpus::getShipMask(int board, int shipId) {
+    int count;
+    const Placement* placements = Fleet::getPlacements(Fleet::getLength(shipId), count);
+    return placements[fleets[board].placements[shipId]].mask;
+}
+
+string BoardCorpus::getLayout(int board) {
+    string layout(100, '-');
+    for (int i = 0; i < Fleet::numShips; i++) {
+        Bitboard mask = getShipMask(board, i);
+        while (mask.any()) {
+            layout[mask.lowest()] = Fleet::ships[i].type;
+            mask.popLowest();
+        }
+    }
+    return layout;
+}
+
+// Same wording as Battleship::getShipsFromFile.
+string BoardCorpus::getMessage(const CorpusError &error) {
+    string position = "row " + to_string(error.row) + ", column " + to_string(error.column);
+    string name = error.source + " (board " + to_string(error.board + 1) + ")";
+    switch (error.error) {
+        case PARSE_UNREADABLE:
+            return "The file '" + error.source + "' cannot be read.";
+        case PARSE_INVALID_PIECE:
+            return name + ", invalid piece in " + position + '.';
+        case PARSE_TOO_MANY_COLUMNS:
+            return name + ", too many columns in row " + to_string(error.row) + '.';
+        case PARSE_NOT_ENOUGH_COLUMNS:
+            return name + ", not enough columns (" + to_string(error.column) + " columns in row " + to_string(error.row) + ").";
+        case PARSE_TOO_MANY_ROWS:
+            return name + ", too many rows.";
+        case PARSE_NOT_ENOUGH_ROWS:
+            return name + ", not enough rows (" + to_string(error.row) + " rows).";
+        case PARSE_INVALID_PLACEMENT:
+            return name + ", incorrect ship placements (" + LayoutValidator::getMessage(error.layout) + ").";
+        default:
+            return name + ", no error.";
+    }
+}
+
+// Maps the files, splits them into boards, then parses the boards across the threads.
+void BoardCorpus::parseFiles(const vector<string> &paths) {
+    struct MappedFile {
+        const char* data;
+        size_t size;
+    };
+    vector<MappedFile> files;
+    vector<BoardText> boards;
+    vector<int> boardSources; // Index into paths of each board.
+
+    for (int i = 0; i < int(paths.size()); i++) {
+        int fd = open(paths[i].c_str(), O_RDONLY);
+        struct stat buffer;
+        if (fd < 0 || fstat(fd, &buffer)) {
+            if (fd >= 0) {
+                close(fd);
+            }
+            errors.push_back({paths[i], 0, PARSE_UNREADABLE, 0, 0, LAYOUT_OK});
+            continue;
+        }
+
+        size_t size = buffer.st_size;
+        void* mapped = (size > 0) ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+        close(fd);
+        if (mapped == MAP_FAILED) {
+            errors.push_back({paths[i], 0, PARSE_UNREADABLE, 0, 0, LAYOUT_OK});
+            continue;
+        }
+        files.push_back({(const char*) mapped, size});
+
+        size_t first = boards.size();
+        splitBoards((const char*) mapped, size, boards);
+        boardSources.resize(boards.size(), i);
+        // An empty file still counts as a board without enough rows.
+        if (boards.size() == first) {
+            errors.push_back({paths[i], 0, PARSE_NOT_ENOUGH_ROWS, 0, 0, LAYOUT_OK});
+        }
+    }
+
+    // Each board writes to its own slot, so the tasks don't share anything.
+    vector<PackedFleet> parsed(boards.size());
+    vector<CorpusError> parseErrors(boards.size());
+    WorkStealingPool pool(numThreads);
+    for (size_t first = 0; first < boards.size(); first += boardsPerTask) {
+        size_t last = min(first + boardsPerTask, boards.size());
+        pool.submit([&, first, last](int) {
+            for (size_t i = first; i < last; i++) {
+                CorpusError &currError = parseErrors[i];
+                currError.error = parseBoard(boards[i], parsed[i], currError.row, currError.column, currError.layout);
+            }
+        });
+    }
+    pool.run();
+
+    // Keep the valid fleets and the errors in file order.
+    for (size_t i = 0; i < boards.size(); i++) {
+        if (parseErrors[i].error == PARSE_OK) {
+            fleets.push_back(parsed[i]);
+        } else {
+            CorpusError &currError = parseErrors[i];
+            currError.source = paths[boardSources[i]];
+            currError.board = boards[i].board;
+            errors.push_back(currError);
+        }
+    }
+
+    for (MappedFile &file : files) {
+        munmap((void*) file.data, file.size);
+    }
+}
+
+// Splits a file into boards at blank lines (lines with only whitespace).
+void BoardCorpus::splitBoards(const char* data, size_t size, vector<BoardText> &boards) {
+    const char* end = data + size;
+    const char* boardBegin = nullptr;
+    const char* lineBegin = data;
+    int numBoards = 0;
+
+    while (lineBegin < end) {
+        const char* lineEnd = (const char*) memchr(lineBegin, '\n', end - lineBegin);
+        lineEnd = lineEnd ? lineEnd : end;
+
+        bool isBlank = true;
+        for (const char* c = lineBegin; c < lineEnd && isBlank; c++) {
+            isBlank = (*c == ' ' || *c == '\t' || *c == '\r');
+        }
+
+        if (!isBlank && !boardBegin) {
+            boardBegin = lineBegin;
+        } else if (isBlank && boardBegin) {
+            boards.push_back({boardBegin, lineBegin, numBoards++});
+            boardBegin = nullptr;
+        }
+        lineBegin = lineEnd + 1;
+    }
+    if (boardBegin) {
+        boards.push_back({boardBegin, end, numBoards++});
+    }
+}
+
+// Reads the pieces into ship masks, then checks them with LayoutValidator.
+ParseError BoardCorpus::parseBoard(const BoardText &text, PackedFleet &fleet, int &row, int &column, LayoutError &layout) {
+    Bitboard ships[Fleet::numShips];
+    const char* lineBegin = text.begin;
+    layout = LAYOUT_OK;
+    row = 0;
+    column = 0;
+
+    while (lineBegin < text.end) {
+        const char* lineEnd = (const char*) memchr(lineBegin, '\n', text.end - lineBegin);
+        lineEnd = lineEnd ? lineEnd : text.end;
+        if (row == 10) {
+            row++;
+            return PARSE_TOO_MANY_ROWS;
+        }
+
+        column = 0;
+        for (const char* c = lineBegin; c < lineEnd; c++) {
+            switch (*c) {
+                case ' ':
+                case '\t':
+                case '\r':
+                    continue;
+                case '-':
+                    break;
+                default: {
+                    int shipId = -1;
+                    for (int i = 0; i < Fleet::numShips; i++) {
+                        shipId = (Fleet::ships[i].type == *c) ? i : shipId;
+                    }
+                    if (shipId < 0) {
+                        row++;
+                        column++;
+                        return PARSE_INVALID_PIECE;
+                    }
+                    if (column < 10) {
+                        ships[shipId].set((row * 10) + column);
+                    }
+                }
+            }
+            column++;
+            if (column > 10) {
+                row++;
+                return PARSE_TOO_MANY_COLUMNS;
+            }
+        }
+        if (column < 10) {
+            row++;
+            return PARSE_NOT_ENOUGH_COLUMNS;
+        }
+        row++;
+        lineBegin = lineEnd + 1;
+    }
+
+    if (row < 10) {
+        return PARSE_NOT_ENOUGH_ROWS;
+    }
+
+    row = 0;
+    column = 0;
+    int shipId;
+    layout = LayoutValidator::validate(ships, shipId);
+    if (layout != LAYOUT_OK) {
+        return PARSE_INVALID_PLACEMENT;
+    }
+    for (int i = 0; i < Fleet::numShips; i++) {
+        fleet.placements[i] = Fleet::getPlacementIndex(ships[i]);
+    }
+    return PARSE_OK;
+}
@@ -0,0 +1,58 @@
+#include "../include/checkerboardStrategy.hpp"
+using namespace std;
+
+const Bitboard CheckerboardStrategy::huntPositions = getHuntPositions();
+
+CheckerboardStrategy::CheckerboardStrategy() {
+    board = nullptr;
+    numTargets = 0;
+}
+
+// Starts a new game against the board.
+void CheckerboardStrategy::reset(Board &board) {
+    this->board = &board;
+    numTargets = 0;
+    queued = Bitboard();
+}
+
+// Shoots the latest target, otherwise a random hunt position (or any position once they're all shot).
+Coordinate CheckerboardStrategy::chooseMove() {
+    while (numTargets > 0) {
+        int cell = targets[--numTargets];
+        if (!board->getShots().test(cell % 10, cell / 10)) {
+            return Coordinate(cell % 10, cell / 10);
+        }
+    }
+
+    Bitboard freePos = ~board->getShots() & Bitboard::full();
+    Bitboard huntPos = freePos & huntPositions;
+    if (huntPos.any()) {
+        freePos = huntPos;
+    }
+    int numFree = freePos.count();
+    if (numFree == 0) {
+        return Coordinate(-1, -1);
+    }
+    int cell = freePos.select(random.nextBelow(numFree));
+    return Coordinate(cell % 10, cell / 10);
+}
+
+// Targets the positions around a hit (a miss or a sunk ship adds nothing).
+void CheckerboardStrategy::recordShot(int x, int y, ShotResult result, int shipId) {
+    if (result != SHOT_HIT) {
+        return;
+    }
+    pushTarget(x, y - 1);
+    pushTarget(x, y + 1);
+    pushTarget(x - 1, y);
+    pushTarget(x + 1, y);
+}
+
+// Adds a position to the targets, once, if it's on the board and hasn't been shot.
+void CheckerboardStrategy::pushTarget(int x, int y) {
+    if (x < 0 || x > 9 || y < 0 || y > 9 || board->isPosHit(x, y) || queued.test(x, y)) {
+        return;
+    }
+    queued |= Bitboard::cell(x, y);
+    targets[numTargets++] = (y * 10) + x;
+}
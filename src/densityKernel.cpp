@@ -0,0 +1,214 @@
+#include "../include/densityKernel.hpp"
+using namespace std;
+
+// SSE2 is part of x86-64, AVX2 is checked for at runtime.
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(BATTLESHIP_NO_SIMD)
+#define BATTLESHIP_X86_SIMD
+#include <immintrin.h>
+#endif
+
+// The 10 positions of a row as bits.
+static unsigned getRowBits(Bitboard positions, int y) {
+    int first = y * 10;
+    if (first + 10 <= 64) {
+        return (positions.lo >> first) & 0x3FF;
+    } else if (first >= 64) {
+        return (positions.hi >> (first - 64)) & 0x3FF;
+    }
+    return ((positions.lo >> first) | (positions.hi << (64 - first))) & 0x3FF;
+}
+
+// Walks each row and column both ways, adding the ships that fit in the run so far.
+static void calculateScalar(Bitboard freePos, const unsigned char weights[6], int density[10][10]) {
+    // Ships that fit in a run of each length (a longer run fits them all).
+    int fits[6] = {0};
+    for (int length = 1; length <= 5; length++) {
+        fits[length] = fits[length - 1] + weights[length];
+    }
+
+    bool isFree[10][10];
+    for (int y = 0; y < 10; y++) {
+        unsigned rowBits = getRowBits(freePos, y);
+        for (int x = 0; x < 10; x++) {
+            isFree[y][x] = (rowBits >> x) & 1;
+            density[y][x] = 0;
+        }
+    }
+
+    for (int i = 0; i < 10; i++) {
+        int left = 0, right = 0, up = 0, down = 0;
+        for (int j = 0; j < 10; j++) {
+            left = isFree[i][j] ? left + 1 : 0;
+            right = isFree[i][9 - j] ? right + 1 : 0;
+            up = isFree[j][i] ? up + 1 : 0;
+            down = isFree[9 - j][i] ? down + 1 : 0;
+            density[i][j] += fits[(left < 5) ? left : 5];
+            density[i][9 - j] += fits[(right < 5) ? right : 5];
+            density[j][i] += fits[(up < 5) ? up : 5];
+            density[9 - j][i] += fits[(down < 5) ? down : 5];
+        }
+    }
+}
+
+#ifdef BATTLESHIP_X86_SIMD
+// A row as 16 byte lanes: 0xFF for a free position, 0 for a shot one or past the row.
+static inline __m128i expandRow(unsigned rowBits) {
+    const __m128i laneBits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, -128, -128, -128, -128, -128, -128);
+    __m128i bytes = _mm_unpacklo_epi64(_mm_set1_epi8(char(rowBits)), _mm_set1_epi8(char(rowBits >> 8)));
+    return _mm_cmpeq_epi8(_mm_and_si128(bytes, laneBits), laneBits);
+}
+
+static void widenDensity(const unsigned char bytes[10][16], int density[10][10]) {
+    for (int y = 0; y < 10; y++) {
+        for (int x = 0; x < 10; x++) {
+            density[y][x] = bytes[y][x];
+        }
+    }
+}
+
+// A row per register. Each length's masks (the position and the length - 1 before it are free)
+// come from the last length's masks and their neighbours', so a row needs one shift per length.
+static void calculateSse2(Bitboard freePos, const unsigned char weights[6], int density[10][10]) {
+    __m128i up[10], down[10], sum[10];
+    for (int y = 0; y < 10; y++) {
+        up[y] = down[y] = expandRow(getRowBits(freePos, y));
+        sum[y] = _mm_setzero_si128();
+    }
+
+    // Along the rows.
+    for (int y = 0; y < 10; y++) {
+        __m128i left = up[y];
+        __m128i right = up[y];
+        for (int length = 2; length <= 5; length++) {
+            __m128i weight = _mm_set1_epi8(char(weights[length]));
+            left = _mm_and_si128(left, _mm_slli_si128(left, 1));
+            right = _mm_and_si128(right, _mm_srli_si128(right, 1));
+            sum[y] = _mm_add_epi8(sum[y], _mm_add_epi8(_mm_and_si128(left, weight), _mm_and_si128(right, weight)));
+        }
+    }
+
+    // Along the columns.
+    for (int length = 2; length <= 5; length++) {
+        __m128i weight = _mm_set1_epi8(char(weights[length]));
+        for (int y = 9; y > 0; y--) {
+            up[y] = _mm_and_si128(up[y], up[y - 1]);
+        }
+        up[0] = _mm_setzero_si128();
+        for (int y = 0; y < 9; y++) {
+            down[y] = _mm_and_si128(down[y], down[y + 1]);
+        }
+        down[9] = _mm_setzero_si128();
+        for (int y = 0; y < 10; y++) {
+            sum[y] = _mm_add_epi8(sum[y], _mm_add_epi8(_mm_and_si128(up[y], weight), _mm_and_si128(down[y], weight)));
+        }
+    }
+
+    alignas(16) unsigned char bytes[10][16];
+    for (int y = 0; y < 10; y++) {
+        _mm_store_si128((__m128i*)bytes[y], sum[y]);
+    }
+    widenDensity(bytes, density);
+}
+
+// Same as calculateSse2, with rows y and y + 5 in the two halves of a register.
+// Rows 4 and 5 are neighbours across the halves, so those masks are moved between halves.
+__attribute__((target("avx2")))
+static void calculateAvx2(Bitboard freePos, const unsigned char weights[6], int density[10][10]) {
+    __m256i up[5], down[5], sum[5];
+    for (int i = 0; i < 5; i++) {
+        __m128i first = expandRow(getRowBits(freePos, i));
+        __m128i second = expandRow(getRowBits(freePos, i + 5));
+        up[i] = down[i] = _mm256_inserti128_si256(_mm256_castsi128_si256(first), second, 1);
+        sum[i] = _mm256_setzero_si256();
+    }
+
+    // Along the rows (shifts stay within each half).
+    for (int i = 0; i < 5; i++) {
+        __m256i left = up[i];
+        __m256i right = up[i];
+        for (int length = 2; length <= 5; length++) {
+            __m256i weight = _mm256_set1_epi8(char(weights[length]));
+            left = _mm256_and_si256(left, _mm256_slli_si256(left, 1));
+            right = _mm256_and_si256(right, _mm256_srli_si256(right, 1));
+            sum[i] = _mm256_add_epi8(sum[i], _mm256_add_epi8(_mm256_and_si256(left, weight), _mm256_and_si256(right, weight)));
+        }
+    }
+
+    // Along the columns.
+    for (int length = 2; length <= 5; length++) {
+        __m256i weight = _mm256_set1_epi8(char(weights[length]));
+        // Above rows 0 and 5 are nothing and row 4, below rows 4 and 9 are row 5 and nothing.
+        __m256i aboveFirst = _mm256_permute2x128_si256(up[4], up[4], 0x08);
+        __m256i belowLast = _mm256_permute2x128_si256(down[0], down[0], 0x81);
+        for (int i = 4; i > 0; i--) {
+            up[i] = _mm256_and_si256(up[i], up[i - 1]);
+        }
+        up[0] = _mm256_and_si256(up[0], aboveFirst);
+        for (int i = 0; i < 4; i++) {
+            down[i] = _mm256_and_si256(down[i], down[i + 1]);
+        }
+        down[4] = _mm256_and_si256(down[4], belowLast);
+        for (int i = 0; i < 5; i++) {
+            sum[i] = _mm256_add_epi8(sum[i], _mm256_add_epi8(_mm256_and_si256(up[i], weight), _mm256_and_si256(down[i], weight)));
+        }
+    }
+
+    alignas(32) unsigned char bytes[10][16];
+    for (int i = 0; i < 5; i++) {
+        _mm_store_si128((__m128i*)bytes[i], _mm256_castsi256_si128(sum[i]));
+        _mm_store_si128((__m128i*)bytes[i + 5], _mm256_extracti128_si256(sum[i], 1));
+    }
+    widenDensity(bytes, density);
+}
+#endif
+
+// Calculates the density with the given level (the scalar one if the CPU doesn't support it).
+void DensityKernel::calculate(KernelLevel level, Bitboard freePos, const int shipLengths[], int numShips,
+                              int density[10][10]) {
+    unsigned char weights[6] = {0}; // Ships of each length.
+    for (int i = 0; i < numShips; i++) {
+        weights[shipLengths[i]]++;
+    }
+
+#ifdef BATTLESHIP_X86_SIMD
+    if (level == AVX2_KERNEL && isSupported(AVX2_KERNEL)) {
+        calculateAvx2(freePos, weights, density);
+        return;
+    } else if (level != SCALAR_KERNEL) {
+        calculateSse2(freePos, weights, density);
+        return;
+    }
+#endif
+    calculateScalar(freePos, weights, density);
+}
+
+// The best level this CPU supports, checked once.
+KernelLevel DensityKernel::getLevel() {
+    static const KernelLevel level = isSupported(AVX2_KERNEL) ? AVX2_KERNEL
+                                     : isSupported(SSE2_KERNEL) ? SSE2_KERNEL : SCALAR_KERNEL;
+    return level;
+}
+
+bool DensityKernel::isSupported(KernelLevel level) {
+#ifdef BATTLESHIP_X86_SIMD
+    switch (level) {
+        case AVX2_KERNEL:
+            return __builtin_cpu_supports("avx2");
+        default:
+            return true;
+    }
+#else
+    return level == SCALAR_KERNEL;
+#endif
+}
+
+string DensityKernel::getLevelName(KernelLevel level) {
+    switch (level) {
+        case AVX2_KERNEL:
+            return "avx2";
+        case SSE2_KERNEL:
+            return "sse2";
+        default:
+            return "scalar";
+    }
+}
@@ -0,0 +1,78 @@
+#include "../include/densityStrategy.hpp"
+#include "../include/metrics.hpp"
+using namespace std;
+
+const Bitboard DensityStrategy::parityMasks[] = {getParityMask(0), getParityMask(1), getParityMask(2),
+                                                 getParityMask(3), getParityMask(4), getParityMask(5)};
+
+// Starts a new game against the board (the probabilities are rebuilt on the next move).
+void DensityStrategy::resetDensity(Board &board) {
+    this->board = &board;
+    for (int i = 0; i < 10; i++) {
+        for (int j = 0; j < 10; j++) {
+            probBoard[i][j] = 0;
+        }
+    }
+    for (int i = 0; i <= Fleet::maxLength; i++) {
+        numLiveShips[i] = 0;
+    }
+    // The ships may not be placed yet, but none of them have sunk.
+    for (int i = 0; i < Fleet::numShips; i++) {
+        numLiveShips[Fleet::getLength(i)]++;
+    }
+    minShipSize = Fleet::minLength;
+    parityOutdated = true;
+}
+
+// The remaining ships (and parity) change when a ship sinks.
+void DensityStrategy::recordShot(int x, int y, ShotResult result, int shipId) {
+    if (result == SHOT_SUNK) {
+        recordSunk(shipId);
+    }
+}
+
+// Removes a sunk ship, moving the smallest ship up if it was the last of its length.
+void DensityStrategy::recordSunk(int shipId) {
+    numLiveShips[Fleet::getLength(shipId)]--;
+    while (minShipSize < Fleet::maxLength && numLiveShips[minShipSize] == 0) {
+        minShipSize++;
+    }
+    parityOutdated = true;
+}
+
+// Shoots the best position of a density that is recalculated every turn (row by row, y * 10 + x).
+// The whole board is one pass over the move keys.
+// Favours positions with even parity: the last one with the largest probability is chosen,
+// otherwise the first position with the largest probability.
+Coordinate DensityStrategy::chooseDensityMove(const int density[100]) {
+    if (parityOutdated) {
+        setParityBoard();
+        parityOutdated = false;
+    }
+    Bitboard shots = board->getShots();
+    long long best = -1;
+    for (int cell = 0; cell < 100; cell++) {
+        long long key = getMoveKey(density[cell], cell, shots.test(cell));
+        best = (key > best) ? key : best;
+    }
+    return getKeyMove(best);
+}
+
+// Sets the parity of every position (it only changes when a ship sinks).
+void DensityStrategy::setParityBoard() {
+    METRIC_ADD(PARITY_REBUILDS, 1);
+    parity = parityMasks[minShipSize];
+    for (int cell = 0; cell < 100; cell++) {
+        tieBreaks[cell] = parity.test(cell) ? 128 + cell : 127 - cell;
+    }
+}
+
+// The position of a move key, (-1, -1) if every position has been hit.
+Coordinate DensityStrategy::getKeyMove(long long key) {
+    if (key < 0) {
+        return Coordinate(-1, -1);
+    }
+    int tieBreak = key & 0xFF;
+    int cell = (tieBreak >= 128) ? tieBreak - 128 : 127 - tieBreak;
+    return Coordinate(cell % 10, cell / 10);
+}
@@ -0,0 +1,365 @@
+#include "../include/endgameSolver.hpp"
+#include <algorithm>
+using namespace std;
+
+EndgameSolver::EndgameSolver() {
+    threshold = defaultThreshold;
+    numFleets = 0;
+    lastExpectedShots = 0;
+    numLiveShips = 0;
+    liveShipBits = 0;
+    clearCandidates();
+}
+
+// The next list starts from every placement.
+void EndgameSolver::clearCandidates() {
+    listedMisses = Bitboard::full();
+    for (int i = 0; i < Fleet::numShips; i++) {
+        listedHits[i] = Bitboard();
+        numCandidates[i] = 0;
+    }
+}
+
+// Deconstructor.
+EndgameSolver::~EndgameSolver() {
+}
+
+void EndgameSolver::setThreshold(int threshold) {
+    threshold = (threshold > 0) ? threshold : 0;
+    this->threshold = (threshold < maxThreshold) ? threshold : maxThreshold;
+    if (threshold > 0 && table.empty()) {
+        fleets.resize(maxThreshold + 1);
+        for (int i = 0; i < Fleet::numShips; i++) {
+            candidates[i].resize(maxPlacements);
+        }
+        table.resize(size_t(1) << tableBits, TableEntry{0, 0, -1, false});
+    }
+}
+
+// Lists the fleets left, and if there are few enough, finds the best position to shoot.
+bool EndgameSolver::chooseMove(const TargetView &view, Coordinate &move) {
+    if (threshold == 0 || !listFleets(view)) {
+        return false;
+    }
+
+    unsigned char indices[maxThreshold];
+    for (int i = 0; i < numFleets; i++) {
+        indices[i] = i;
+    }
+    int bestCell;
+    double expectedMisses = solve(indices, numFleets, noLimit, bestCell);
+
+    // Every position left on the real fleet is a hit.
+    Bitboard shots = view.misses;
+    for (int i = 0; i < Fleet::numShips; i++) {
+        shots |= view.shipHits[i];
+    }
+    int positionsLeft = 0;
+    for (int i = 0; i < numFleets; i++) {
+        positionsLeft += (fleets[i].occupied & ~shots).count();
+    }
+    lastExpectedShots = double(positionsLeft) / numFleets + expectedMisses;
+
+    // With one fleet left, its positions can go in any order.
+    if (numFleets == 1) {
+        bestCell = (fleets[0].occupied & ~shots).lowest();
+    }
+    move = Coordinate(bestCell % 10, bestCell / 10);
+    return true;
+}
+
+// Lists every fleet that agrees with the view, false (and stops early) if there are more than the threshold.
+bool EndgameSolver::listFleets(const TargetView &view) {
+    Bitboard shots = view.misses;
+    for (int i = 0; i < Fleet::numShips; i++) {
+        shots |= view.shipHits[i];
+    }
+
+    // Shots are only ever added in a game, so if the view has every shot of the last one, only
+    // the placements that agreed then can agree now.
+    bool isLater = (listedMisses & ~view.misses).empty();
+    for (int i = 0; i < Fleet::numShips; i++) {
+        isLater = isLater && (listedHits[i] & ~view.shipHits[i]).empty();
+        listedHits[i] = view.shipHits[i];
+    }
+    listedMisses = view.misses;
+
+    // A ship's placements avoid every other shot and cover all of its hits.
+    numLiveShips = 0;
+    liveShipBits = 0;
+    for (int shipId = 0; shipId < Fleet::numShips; shipId++) {
+        if (view.isSunk[shipId]) {
+            continue;
+        }
+        Bitboard blocked = shots & ~view.shipHits[shipId];
+        int count = numCandidates[shipId];
+        const Placement* placements = nullptr;
+        if (!isLater) {
+            placements = Fleet::getPlacements(Fleet::getLength(shipId), count);
+        }
+
+        numCandidates[shipId] = 0;
+        for (int i = 0; i < count; i++) {
+            Bitboard mask = placements ? placements[i].mask : candidates[shipId][i];
+            if ((mask & blocked).empty() && (mask & view.shipHits[shipId]) == view.shipHits[shipId]) {
+                candidates[shipId][numCandidates[shipId]++] = mask;
+            }
+        }
+
+        // Insertion by candidate count, so the search branches on the most constrained ship first.
+        int slot = numLiveShips++;
+        while (slot > 0 && numCandidates[liveShips[slot - 1]] > numCandidates[shipId]) {
+            liveShips[slot] = liveShips[slot - 1];
+            slot--;
+        }
+        liveShips[slot] = shipId;
+        liveShipBits |= 1 << shipId;
+    }
+
+    // The product bounds the fleets from above; far over the threshold, the listing isn't worth it.
+    double product = 1;
+    for (int i = 0; i < numLiveShips; i++) {
+        product *= numCandidates[liveShips[i]];
+    }
+    if (product > double(threshold) * maxProductRatio) {
+        numFleets = threshold + 1;
+        return false;
+    }
+
+    numFleets = 0;
+    EndgameFleet current;
+    for (int i = 0; i < Fleet::numShips; i++) {
+        current.ships[i] = Bitboard();
+    }
+    addFleets(0, Bitboard(), current);
+    if (numFleets == 0 || numFleets > threshold) {
+        return false;
+    }
+
+    for (int i = 0; i < numFleets; i++) {
+        EndgameFleet &fleet = fleets[i];
+        for (int cell = 0; cell < 100; cell++) {
+            fleet.shipAt[cell] = Fleet::numShips;
+        }
+        for (int j = 0; j < numLiveShips; j++) {
+            Bitboard positions = fleet.ships[liveShips[j]];
+            while (positions.any()) {
+                fleet.shipAt[positions.lowest()] = liveShips[j];
+                positions.popLowest();
+            }
+        }
+    }
+    return true;
+}
+
+// Places the ship at depth in every free spot, then the next ship, keeping each complete fleet.
+// Stops once there are more fleets than the threshold.
+void EndgameSolver::addFleets(int depth, Bitboard occupied, EndgameFleet &current) {
+    if (depth == numLiveShips) {
+        if (numFleets <= threshold) {
+            fleets[numFleets].occupied = occupied;
+            for (int i = 0; i < Fleet::numShips; i++) {
+                fleets[numFleets].ships[i] = current.ships[i];
+            }
+        }
+        numFleets++;
+        return;
+    }
+
+    int shipId = liveShips[depth];
+    for (int i = 0; i < numCandidates[shipId] && numFleets <= threshold; i++) {
+        Bitboard mask = candidates[shipId][i];
+        if ((mask & occupied).empty()) {
+            current.ships[shipId] = mask;
+            addFleets(depth + 1, occupied | mask, current);
+        }
+    }
+    current.ships[shipId] = Bitboard();
+}
+
+// Expected misses before the fleet has sunk, out of the fleets in indices, and the position to shoot
+// next (-1 if there's only one fleet). Every position left on the real fleet takes a shot whatever
+// the order, so fewer misses is fewer shots.
+// Only the fleets matter: a position every fleet agrees on (no ship, or the same ship) tells
+// nothing, so it doesn't matter whether it's been shot. The table key is the misses and hits those
+// positions imply, which every way of reaching the same fleets shares, and the result is rounded
+// like the table's, so it's the same whether or not it came from there.
+// The search gives up on a position once it can't be less than limit, and returns a lower bound
+// (at least limit, with no position) instead. The table keeps those apart from the solved positions.
+double EndgameSolver::solve(const unsigned char indices[], int count, double limit, int &bestCell) {
+    bestCell = -1;
+    if (count == 1) {
+        return 0;
+    }
+
+    Bitboard occupied;
+    Bitboard agreedHits[Fleet::numShips];
+    uint64_t key = getKey(indices, count, occupied, agreedHits);
+    Bitboard targets = occupied;
+    for (int shipId = 0; shipId < Fleet::numShips; shipId++) {
+        targets &= ~agreedHits[shipId];
+    }
+
+    TableEntry &entry = table[key & ((uint64_t(1) << tableBits) - 1)];
+    if (entry.key == key && (!entry.isBound || entry.expectedMisses >= limit)) {
+        bestCell = entry.bestCell;
+        return entry.expectedMisses;
+    }
+
+    // The other positions by the fleets with a ship there, most first.
+    int coverage[100] = {0};
+    for (int i = 0; i < count; i++) {
+        Bitboard positions = fleets[indices[i]].occupied & targets;
+        while (positions.any()) {
+            coverage[positions.lowest()]++;
+            positions.popLowest();
+        }
+    }
+    int orderedTargets[100];
+    int numTargets = 0;
+    while (targets.any()) {
+        int cell = targets.lowest();
+        targets.popLowest();
+        int slot = numTargets++;
+        while (slot > 0 && coverage[orderedTargets[slot - 1]] < coverage[cell]) {
+            orderedTargets[slot] = orderedTargets[slot - 1];
+            slot--;
+        }
+        orderedTargets[slot] = cell;
+    }
+    // A position every fleet has a ship on can't miss and only tells more, so it goes first.
+    if (numTargets > 0 && coverage[orderedTargets[0]] == count) {
+        numTargets = 1;
+    }
+
+    // Positions that split the fleets the same way (often the rest of a ship) are the same shot,
+    // so only the first is searched.
+    uint64_t splits[100];
+    int numSplits = 0;
+    for (int target = 0; target < numTargets; target++) {
+        int cell = orderedTargets[target];
+        uint64_t split = 0;
+        for (int i = 0; i < count; i++) {
+            split = (split ^ fleets[indices[i]].shipAt[cell]) * 0x100000001B3ULL;
+        }
+        bool isRepeat = false;
+        for (int j = 0; j < numSplits && !isRepeat; j++) {
+            isRepeat = (splits[j] == split && coverage[orderedTargets[j]] == coverage[cell]
+                        && isSameSplit(indices, count, orderedTargets[j], cell));
+        }
+        if (!isRepeat) {
+            orderedTargets[numSplits] = cell;
+            splits[numSplits++] = split;
+        }
+    }
+    numTargets = numSplits;
+
+    // A shot splits the fleets by what it hits (a miss or one of the ships), and each part is
+    // solved on its own. It misses at least as often as the fleets it doesn't cover.
+    double bestMisses = limit;
+    double lowerBound = noLimit; // The fewest misses a position given up on could have.
+    unsigned char groups[Fleet::numShips + 1][maxThreshold];
+    int groupSizes[Fleet::numShips + 1];
+    for (int target = 0; target < numTargets; target++) {
+        int cell = orderedTargets[target];
+        double expected = double(count - coverage[cell]) / count;
+        if (expected >= bestMisses) {
+            lowerBound = min(lowerBound, expected);
+            break;
+        }
+        for (int i = 0; i <= Fleet::numShips; i++) {
+            groupSizes[i] = 0;
+        }
+        for (int i = 0; i < count; i++) {
+            int group = fleets[indices[i]].shipAt[cell];
+            groups[group][groupSizes[group]++] = indices[i];
+        }
+
+        // The parts the table already has may rule it out before any is solved.
+        double knownMisses = expected;
+        for (int group = 0; group <= Fleet::numShips; group++) {
+            if (groupSizes[group] > 1) {
+                knownMisses += getKnownMisses(groups[group], groupSizes[group]) * groupSizes[group] / count;
+            }
+        }
+        if (knownMisses >= bestMisses + limitSlack) {
+            lowerBound = min(lowerBound, knownMisses);
+            continue;
+        }
+
+        // Stops adding up once it can't beat the best position so far. Each part only needs solving
+        // while it could, give or take rounding (so a part only gives up when the whole would too).
+        for (int group = 0; group <= Fleet::numShips && expected < bestMisses; group++) {
+            if (groupSizes[group] > 0) {
+                int childBest;
+                double childLimit = (bestMisses - expected) * count / groupSizes[group] + limitSlack;
+                expected += solve(groups[group], groupSizes[group], childLimit, childBest) * groupSizes[group] / count;
+            }
+        }
+        if (expected < bestMisses) {
+            bestMisses = expected;
+            bestCell = cell;
+        } else {
+            lowerBound = min(lowerBound, expected);
+        }
+    }
+
+    // Deeper positions may have used the same entry, it always goes to the latest.
+    if (bestCell < 0) {
+        entry = TableEntry{key, float(lowerBound), -1, true};
+        return lowerBound;
+    }
+    entry = TableEntry{key, float(bestMisses), short(bestCell), false};
+    return entry.expectedMisses;
+}
+
+bool EndgameSolver::isSameSplit(const unsigned char indices[], int count, int firstCell, int secondCell) {
+    for (int i = 0; i < count; i++) {
+        if (fleets[indices[i]].shipAt[firstCell] != fleets[indices[i]].shipAt[secondCell]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Finds the positions the fleets agree on (the positions any has a ship on, and each ship's
+// positions in all of them), and mixes those misses and hits with the unsunk ships into a key
+// (never 0, which marks an empty entry).
+uint64_t EndgameSolver::getKey(const unsigned char indices[], int count, Bitboard &occupied, Bitboard agreedHits[]) {
+    occupied = Bitboard();
+    for (int shipId = 0; shipId < Fleet::numShips; shipId++) {
+        agreedHits[shipId] = Bitboard::full();
+    }
+    for (int i = 0; i < count; i++) {
+        const EndgameFleet &fleet = fleets[indices[i]];
+        occupied |= fleet.occupied;
+        for (int shipId = 0; shipId < Fleet::numShips; shipId++) {
+            agreedHits[shipId] &= fleet.ships[shipId];
+        }
+    }
+    Bitboard misses = ~occupied & Bitboard::full();
+
+    uint64_t key = 0x9E3779B97F4A7C15ULL;
+    auto mix = [&key](uint64_t word) {
+        key ^= word;
+        key *= 0xBF58476D1CE4E5B9ULL;
+        key ^= key >> 31;
+    };
+    mix(liveShipBits);
+    mix(misses.lo);
+    mix(misses.hi);
+    for (int i = 0; i < Fleet::numShips; i++) {
+        mix(agreedHits[i].lo);
+        mix(agreedHits[i].hi);
+    }
+    return key | 1;
+}
+
+// The expected misses of the fleets if the table has them, else a lower bound (0 if it has nothing).
+double EndgameSolver::getKnownMisses(const unsigned char indices[], int count) {
+    Bitboard occupied;
+    Bitboard agreedHits[Fleet::numShips];
+    uint64_t key = getKey(indices, count, occupied, agreedHits);
+    const TableEntry &entry = table[key & ((uint64_t(1) << tableBits) - 1)];
+    return (entry.key == key) ? entry.expectedMisses : 0;
+}
@@ -0,0 +1,49 @@
+#include "../include/exactDensity.hpp"
+
+// Adds up the weight of every legal placement on the positions it covers.
+void ExactDensity::calculate(const TargetView &view, int density[100]) {
+    Bitboard allHits;
+    for (int i = 0; i < Board::numShips; i++) {
+        allHits |= view.shipHits[i];
+    }
+    Bitboard shots = view.misses | allHits;
+
+    for (int i = 0; i < 100; i++) {
+        density[i] = 0;
+    }
+
+    addShipDensity<0>(view, allHits, density);
+
+    // Positions already shot can't be chosen.
+    for (int i = 0; i < 100; i++) {
+        density[i] *= !shots.test(i);
+    }
+}
+
+// Adds the density of one ship, then moves on to the next one.
+// The ship's length is known at compile time, so the walk along each placement unrolls.
+template <int ShipId>
+void ExactDensity::addShipDensity(const TargetView &view, Bitboard allHits, int density[100]) {
+    constexpr int shipLength = Fleet::getLength(ShipId);
+    constexpr const PlacementTable<shipLength> &table = placementTable<shipLength>;
+
+    if (!view.isSunk[ShipId]) {
+        // A placement can't cover a miss or another ship's hit, and must cover all of this ship's hits.
+        Bitboard blocked = view.misses | (allHits & ~view.shipHits[ShipId]);
+        Bitboard mustCover = view.shipHits[ShipId];
+        int weight = mustCover.any() ? damagedShipWeight : 1;
+
+        for (int j = 0; j < table.count; j++) {
+            const Placement &currPlacement = table.placements[j];
+            bool isLegal = (currPlacement.mask & blocked).empty() && (currPlacement.mask & mustCover) == mustCover;
+            int currWeight = weight * isLegal;
+            for (int k = 0; k < shipLength; k++) {
+                density[currPlacement.start + (k * currPlacement.step)] += currWeight;
+            }
+        }
+    }
+
+    if constexpr (ShipId + 1 < Fleet::numShips) {
+        addShipDensity<ShipId + 1>(view, allHits, density);
+    }
+}
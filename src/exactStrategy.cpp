@@ -0,0 +1,17 @@
+#include "../include/exactStrategy.hpp"
+#include "../include/exactDensity.hpp"
+#include "../include/metrics.hpp"
+using namespace std;
+
+// Shoots the position covered by the most legal placements (the density changes everywhere, so it's always recounted).
+Coordinate ExactStrategy::chooseMove() {
+    Coordinate endgameMove(-1, -1);
+    if (chooseEndgameMove(endgameMove)) {
+        return endgameMove;
+    }
+    int density[100];
+    ExactDensity::calculate(board->getTargetView(), density);
+    METRIC_ADD(PROBABILITY_PASSES, 1);
+    METRIC_ADD(PROBABILITY_CELLS, 100 - board->getShots().count());
+    return chooseDensityMove(density);
+}
@@ -0,0 +1,48 @@
+#include "../include/fleet.hpp"
+
+const Placement* Fleet::getPlacements(int length, int &count) {
+    switch (length) {
+        case 5:
+            count = placementTable<5>.count;
+            return placementTable<5>.placements;
+        case 4:
+            count = placementTable<4>.count;
+            return placementTable<4>.placements;
+        case 3:
+            count = placementTable<3>.count;
+            return placementTable<3>.placements;
+        default:
+            count = placementTable<2>.count;
+            return placementTable<2>.placements;
+    }
+}
+
+int Fleet::getPlacementIndex(Bitboard mask) {
+    int length = mask.count();
+    if (length < minLength || length > maxLength) {
+        return -1;
+    }
+
+    // The start is the lowest position, the next position gives the direction.
+    int start = mask.lowest();
+    int step = mask.test(start + 1) ? 1 : 10;
+    int index;
+    switch (length) {
+        case 5:
+            index = placementTable<5>.getIndex(start, step);
+            break;
+        case 4:
+            index = placementTable<4>.getIndex(start, step);
+            break;
+        case 3:
+            index = placementTable<3>.getIndex(start, step);
+            break;
+        default:
+            index = placementTable<2>.getIndex(start, step);
+            break;
+    }
+
+    int count;
+    const Placement* placements = getPlacements(length, count);
+    return (index >= 0 && index < count && placements[index].mask == mask) ? index : -1;
+}
@@ -0,0 +1,215 @@
+#include "../include/fleetSampler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <thread>
+using namespace std;
+
+FleetSampler::FleetSampler() {
+    seed = 1;
+    jobNumber = 0;
+    numBusyWorkers = 0;
+    currentTurn = nullptr;
+    isStopping = false;
+    reset();
+}
+
+void FleetSampler::reset() {
+    stopWorkers();
+    numThreads = 1;
+    turn = 0;
+    latencyBudget = 0;
+    maxSamples = 20000;
+    tolerance = 0.01;
+    lastSampleCount = 0;
+    numOptions = 0;
+}
+
+// Deconstructor stops the worker threads.
+FleetSampler::~FleetSampler() {
+    stopWorkers();
+}
+
+void FleetSampler::estimate(const TargetView &view, double occupancy[100]) {
+    auto budget = chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double, milli>(latencyBudget));
+    auto deadline = chrono::steady_clock::now() + budget;
+    turn++;
+
+    Bitboard allHits;
+    Bitboard sunkShips;
+    for (int i = 0; i < Board::numShips; i++) {
+        allHits |= view.shipHits[i];
+        if (view.isSunk[i]) {
+            sunkShips |= view.shipHits[i]; // A sunk ship's hits are all of its positions.
+        }
+    }
+    Bitboard shots = view.misses | allHits;
+
+    // List the legal placements of every unsunk ship.
+    numOptions = 0;
+    for (int i = 0; i < Board::numShips; i++) {
+        if (view.isSunk[i]) {
+            continue;
+        }
+        Bitboard blocked = view.misses | (allHits & ~view.shipHits[i]);
+        Bitboard mustCover = view.shipHits[i];
+
+        ShipOptions &currOptions = options[numOptions];
+        currOptions.count = 0;
+        int count;
+        const Placement* placements = Fleet::getPlacements(Board::getShipLength(i), count);
+        for (int j = 0; j < count; j++) {
+            Bitboard mask = placements[j].mask;
+            // The ship isn't sunk, so at least one of its positions hasn't been shot.
+            if ((mask & blocked).empty() && (mask & mustCover) == mustCover && (mask & ~shots).any()) {
+                currOptions.placements[currOptions.count++] = mask;
+            }
+        }
+        order[numOptions] = numOptions;
+        numOptions++;
+    }
+    // Placing the most constrained ships first rejects bad samples sooner.
+    sort(order, order + numOptions, [this](int a, int b) {
+        return options[a].count < options[b].count;
+    });
+
+    // The calling thread is worker 0, the others wait for the turn's tallies.
+    SampleTurn sampleTurn;
+    sampleTurn.shots = shots;
+    sampleTurn.sunkShips = sunkShips;
+    sampleTurn.deadline = deadline;
+    if (numThreads > 1) {
+        startWorkers();
+        {
+            lock_guard<mutex> guard(poolLock);
+            currentTurn = &sampleTurn;
+            numBusyWorkers = numThreads - 1;
+            jobNumber++;
+        }
+        poolWake.notify_all();
+    }
+    sampleBatches(0, sampleTurn);
+    if (numThreads > 1) {
+        unique_lock<mutex> lock(poolLock);
+        poolDone.wait(lock, [this] { return numBusyWorkers == 0; });
+        currentTurn = nullptr;
+    }
+
+    long long numSamples = sampleTurn.numSamples;
+    const long long* counts = sampleTurn.counts;
+    lastSampleCount = int(numSamples);
+    for (int i = 0; i < 100; i++) {
+        occupancy[i] = (numSamples > 0) ? double(counts[i]) / numSamples : 0;
+    }
+}
+
+// Draws batches of samples and adds them to the turn's tallies, until they're good enough.
+void FleetSampler::sampleBatches(int threadId, SampleTurn &sampleTurn) {
+    FastRandom random(seed ^ (turn * 0x9E3779B97F4A7C15ULL) ^ (uint64_t(threadId) << 32));
+    long long localCounts[100];
+    while (!sampleTurn.isDone) {
+        fill(localCounts, localCounts + 100, 0);
+        int drawn = 0;
+        for (int i = 0; i < batchSize; i++) {
+            Bitboard fleet;
+            if (!drawSample(sampleTurn.sunkShips, random, fleet)) {
+                continue;
+            }
+            drawn++;
+            // Only count positions that haven't been shot.
+            fleet &= ~sampleTurn.shots;
+            while (fleet.any()) {
+                localCounts[fleet.lowest()]++;
+                fleet.popLowest();
+            }
+        }
+
+        lock_guard<mutex> guard(sampleTurn.tallyLock);
+        long long* counts = sampleTurn.counts;
+        for (int i = 0; i < 100; i++) {
+            counts[i] += localCounts[i];
+        }
+        sampleTurn.numSamples += drawn;
+        long long numSamples = sampleTurn.numSamples;
+
+        // Stop on the budget, or once the leader is stable and its estimate is precise enough.
+        int leader = int(max_element(counts, counts + 100) - counts);
+        double p = (numSamples > 0) ? double(counts[leader]) / numSamples : 0;
+        double stdError = (numSamples > 0) ? sqrt((p * (1 - p)) / numSamples) : 1;
+        bool isConverged = (leader == sampleTurn.prevLeader) && (stdError < tolerance);
+        sampleTurn.prevLeader = leader;
+        bool isLate = (latencyBudget > 0) && chrono::steady_clock::now() >= sampleTurn.deadline;
+        if (isConverged || numSamples >= maxSamples || isLate) {
+            sampleTurn.isDone = true;
+        }
+    }
+}
+
+// Starts the other numThreads - 1 threads if they aren't running (they're kept until reset).
+void FleetSampler::startWorkers() {
+    if (int(workers.size()) == numThreads - 1) {
+        return;
+    }
+    stopWorkers();
+    for (int i = 1; i < numThreads; i++) {
+        workers.push_back(thread(&FleetSampler::workerLoop, this, i, jobNumber));
+    }
+}
+
+void FleetSampler::stopWorkers() {
+    {
+        lock_guard<mutex> guard(poolLock);
+        isStopping = true;
+    }
+    poolWake.notify_all();
+    for (thread &worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    isStopping = false;
+}
+
+// Samples each turn after lastJob it's woken for, until stopped.
+void FleetSampler::workerLoop(int threadId, uint64_t lastJob) {
+    unique_lock<mutex> lock(poolLock);
+    while (true) {
+        poolWake.wait(lock, [&] { return isStopping || jobNumber != lastJob; });
+        if (isStopping) {
+            return;
+        }
+        lastJob = jobNumber;
+        SampleTurn &sampleTurn = *currentTurn;
+        lock.unlock();
+        sampleBatches(threadId, sampleTurn);
+        lock.lock();
+        if (--numBusyWorkers == 0) {
+            poolDone.notify_all();
+        }
+    }
+}
+
+// Draws one fleet uniformly from the layouts that agree with the shots (rejecting overlaps).
+bool FleetSampler::drawSample(Bitboard sunkShips, FastRandom &random, Bitboard &fleet) const {
+    for (int attempt = 0; attempt < maxAttempts; attempt++) {
+        fleet = sunkShips;
+        bool isValid = true;
+        for (int i = 0; i < numOptions; i++) {
+            const ShipOptions &currOptions = options[order[i]];
+            if (currOptions.count == 0) {
+                return false;
+            }
+            Bitboard placement = currOptions.placements[random.nextBelow(currOptions.count)];
+            if ((placement & fleet).any()) {
+                isValid = false;
+                break;
+            }
+            fleet |= placement;
+        }
+        if (isValid) {
+            return true;
+        }
+    }
+    return false;
+}
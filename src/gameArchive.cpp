@@ -0,0 +1,116 @@
+#include "../include/gameArchive.hpp"
+#include <cstring>
+#include <stdexcept>
+using namespace std;
+
+const char GameArchive::magic[4] = {'B', 'S', 'G', 'A'};
+
+// Collects the fleets and shots of a game (Player 2's board is left out if it has no ships).
+GameRecord GameArchive::makeRecord(Battleship &game) {
+    GameRecord record;
+    record.seed = game.getSeed();
+    record.winner = game.isP1Win() + (2 * game.isP2Win());
+    record.numBoards = game.getBoard(2).occupied().any() ? 2 : 1;
+
+    for (int i = 0; i < record.numBoards; i++) {
+        Board &currBoard = game.getBoard(i + 1);
+        BoardRecord &currRecord = record.boards[i];
+        for (int j = 0; j < Fleet::numShips; j++) {
+            int index = Fleet::getPlacementIndex(currBoard.getShipMask(j));
+            currRecord.fleet[j] = (index >= 0) ? index : noShot;
+            currRecord.sunkAt[j] = noShot;
+        }
+
+        // A ship sinks on the shot at its last unhit position.
+        Bitboard hitSoFar;
+        currRecord.numShots = currBoard.getNumShots();
+        for (int j = 0; j < currRecord.numShots; j++) {
+            int pos = currBoard.getShot(j);
+            bool isHit = currBoard.getHits().test(pos);
+            currRecord.shots[j] = pos | (isHit ? hitFlag : 0);
+            if (!isHit) {
+                continue;
+            }
+            hitSoFar.set(pos);
+            for (int k = 0; k < Fleet::numShips; k++) {
+                Bitboard shipMask = currBoard.getShipMask(k);
+                if (shipMask.test(pos) && (shipMask & ~hitSoFar).empty()) {
+                    currRecord.sunkAt[k] = j;
+                }
+            }
+        }
+    }
+    return record;
+}
+
+int GameArchive::encode(const GameRecord &record, unsigned char* out) {
+    memcpy(out, &record.seed, 8);
+    out[8] = record.winner;
+    out[9] = record.numBoards;
+    int size = 10;
+    for (int i = 0; i < record.numBoards; i++) {
+        const BoardRecord &currRecord = record.boards[i];
+        memcpy(out + size, currRecord.fleet, Fleet::numShips);
+        memcpy(out + size + Fleet::numShips, currRecord.sunkAt, Fleet::numShips);
+        size += 2 * Fleet::numShips;
+        out[size++] = currRecord.numShots;
+        memcpy(out + size, currRecord.shots, currRecord.numShots);
+        size += currRecord.numShots;
+    }
+    return size;
+}
+
+ArchiveWriter::ArchiveWriter() {
+    numRecords = 0;
+    buffer.resize(1 << 16);
+}
+
+// Deconstructor.
+ArchiveWriter::~ArchiveWriter() { }
+
+// Opens the archive for appending, the header is written if the file is new.
+void ArchiveWriter::open(string fileName) {
+    archiveFile.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    archiveFile.open(fileName, ios::binary | ios::app | ios::ate);
+    if (!archiveFile.is_open()) {
+        throw runtime_error("The archive '" + fileName + "' cannot be written.");
+    }
+    if (archiveFile.tellp() == 0) {
+        archiveFile.write(GameArchive::magic, 4);
+        archiveFile.put(GameArchive::version);
+    }
+}
+
+void ArchiveWriter::write(const GameRecord &record) {
+    unsigned char encoded[GameArchive::maxRecordSize];
+    int size = GameArchive::encode(record, encoded);
+    lock_guard<mutex> guard(writeLock);
+    archiveFile.write((const char*) encoded, size);
+    numRecords++;
+}
+
+void ArchiveWriter::writeEncoded(const unsigned char* data, size_t size) {
+    lock_guard<mutex> guard(writeLock);
+    archiveFile.write((const char*) data, size);
+    // Count the records by walking their sizes.
+    for (size_t offset = 0; offset < size; numRecords++) {
+        int numBoards = data[offset + 9];
+        offset += 10;
+        for (int i = 0; i < numBoards; i++) {
+            offset += (2 * Fleet::numShips) + 1 + data[offset + (2 * Fleet::numShips)];
+        }
+    }
+}
+
+uint64_t GameView::getSeed() const {
+    uint64_t seed;
+    memcpy(&seed, data, 8);
+    return seed;
+}
+
+Bitboard GameView::getShipMask(int board, int shipId) const {
+    int count;
+    const Placement* placements = Fleet::getPlacements(Fleet::getLength(shipId), count);
+    int index = getFleetIndex(board, shipId);
+    return (index < count) ? placements[index].mask : Bitboard();
+}
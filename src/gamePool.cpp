@@ -0,0 +1,23 @@
+#include "../include/gamePool.hpp"
+using namespace std;
+
+GamePool::GamePool() { }
+
+// Deconstructor.
+GamePool::~GamePool() { }
+
+Battleship* GamePool::acquire(int numPlayers) {
+    if (numPlayers == 1) {
+        return cpuGames.acquire();
+    }
+    return twoPlayerGames.acquire();
+}
+
+void GamePool::release(Battleship* game) {
+    BattleshipCPU* cpuGame = dynamic_cast<BattleshipCPU*>(game);
+    if (cpuGame) {
+        cpuGames.release(cpuGame);
+    } else {
+        twoPlayerGames.release(game);
+    }
+}
@@ -0,0 +1,349 @@
+#include "../include/gameServer.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+using namespace std;
+
+// Socket errors, with the reason from errno.
+static runtime_error socketError(const string &action) {
+    return runtime_error(action + " failed: " + strerror(errno));
+}
+
+static void setNonBlocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+GameServer::GameServer(int numWorkers) {
+    this->numWorkers = (numWorkers > 0) ? numWorkers : 1;
+    listenFd = -1;
+    port = 0;
+    numSessions = 0;
+    numRequests = 0;
+    stopFd = eventfd(0, EFD_NONBLOCK);
+    if (stopFd < 0) {
+        throw socketError("eventfd");
+    }
+}
+
+// Deconstructor closes the sockets (and removes the Unix socket file).
+GameServer::~GameServer() {
+    if (listenFd >= 0) {
+        close(listenFd);
+    }
+    if (!unixPath.empty()) {
+        unlink(unixPath.c_str());
+    }
+    close(stopFd);
+}
+
+void GameServer::listenTcp(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw socketError("socket");
+    }
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (bind(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+        close(fd);
+        throw socketError("bind to port " + to_string(port));
+    }
+
+    // Find out which port was picked.
+    socklen_t length = sizeof(address);
+    getsockname(fd, (sockaddr*)&address, &length);
+    this->port = ntohs(address.sin_port);
+    startListening(fd);
+}
+
+void GameServer::listenUnix(const string &path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw socketError("socket");
+    }
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path.length() >= sizeof(address.sun_path)) {
+        close(fd);
+        throw runtime_error("The socket path '" + path + "' is too long.");
+    }
+    strcpy(address.sun_path, path.c_str());
+    unlink(path.c_str()); // Left over from a previous run.
+    if (bind(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+        close(fd);
+        throw socketError("bind to " + path);
+    }
+    unixPath = path;
+    startListening(fd);
+}
+
+void GameServer::startListening(int fd) {
+    if (listen(fd, SOMAXCONN) < 0) {
+        close(fd);
+        throw socketError("listen");
+    }
+    setNonBlocking(fd);
+    listenFd = fd;
+}
+
+void GameServer::run() {
+    if (listenFd < 0) {
+        throw runtime_error("The server isn't listening on a socket.");
+    }
+
+    for (int i = 0; i < numWorkers; i++) {
+        unique_ptr<Worker> worker(new Worker());
+        worker->epollFd = epoll_create1(0);
+        worker->wakeFd = eventfd(0, EFD_NONBLOCK);
+        // The event data tells the loop which descriptor is ready (connections use their pointer).
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.ptr = &stopFd;
+        epoll_ctl(worker->epollFd, EPOLL_CTL_ADD, stopFd, &event);
+        event.data.ptr = &worker->wakeFd;
+        epoll_ctl(worker->epollFd, EPOLL_CTL_ADD, worker->wakeFd, &event);
+        workers.push_back(move(worker));
+    }
+    for (unique_ptr<Worker> &worker : workers) {
+        worker->loop = thread(&GameServer::workerLoop, this, ref(*worker));
+    }
+
+    // Accept connections until stopped.
+    int acceptFd = epoll_create1(0);
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = listenFd;
+    epoll_ctl(acceptFd, EPOLL_CTL_ADD, listenFd, &event);
+    event.data.fd = stopFd;
+    epoll_ctl(acceptFd, EPOLL_CTL_ADD, stopFd, &event);
+
+    // While accepting is paused, the listening socket is left out of the wait (it stays readable).
+    int nextWorker = 0;
+    bool isStopping = false;
+    bool isPaused = false;
+    while (!isStopping) {
+        epoll_event events[2];
+        int numEvents = epoll_wait(acceptFd, events, 2, isPaused ? acceptPauseMillis : -1);
+        if (isPaused && numEvents == 0) {
+            isPaused = false;
+            event.events = EPOLLIN;
+            event.data.fd = listenFd;
+            epoll_ctl(acceptFd, EPOLL_CTL_MOD, listenFd, &event);
+        }
+        for (int i = 0; i < numEvents; i++) {
+            if (events[i].data.fd == stopFd) {
+                isStopping = true;
+            } else if (!acceptConnections(nextWorker)) {
+                isPaused = true;
+                event.events = 0;
+                event.data.fd = listenFd;
+                epoll_ctl(acceptFd, EPOLL_CTL_MOD, listenFd, &event);
+            }
+        }
+    }
+    close(acceptFd);
+
+    for (unique_ptr<Worker> &worker : workers) {
+        worker->loop.join();
+        // Accepted while stopping, but never served.
+        for (Connection* connection : worker->newConnections) {
+            close(connection->fd);
+            delete connection;
+        }
+        close(worker->epollFd);
+        close(worker->wakeFd);
+    }
+    workers.clear();
+}
+
+void GameServer::stop() {
+    uint64_t one = 1;
+    ssize_t written = write(stopFd, &one, sizeof(one));
+    (void)written;
+}
+
+// Hands every waiting connection to the next worker. Returns false if accepting should pause:
+// out of descriptors (or memory), the connection stays queued and the listening socket stays readable.
+bool GameServer::acceptConnections(int &nextWorker) {
+    while (true) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            // EAGAIN once there are no more (other errors only lose that client).
+            return errno != EMFILE && errno != ENFILE && errno != ENOBUFS && errno != ENOMEM;
+        }
+        setNonBlocking(fd);
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay)); // Fails harmlessly on Unix sockets.
+
+        Worker &worker = *workers[nextWorker];
+        Connection* connection = new Connection(fd, worker.games);
+        nextWorker = (nextWorker + 1) % numWorkers;
+        {
+            lock_guard<mutex> guard(worker.lock);
+            worker.newConnections.push_back(connection);
+        }
+        uint64_t one = 1;
+        ssize_t written = write(worker.wakeFd, &one, sizeof(one));
+        (void)written;
+        numSessions++;
+    }
+}
+
+// Serves the worker's connections until the server stops.
+void GameServer::workerLoop(Worker &worker) {
+    epoll_event events[maxEvents];
+    bool isStopping = false;
+    while (!isStopping) {
+        int numEvents = epoll_wait(worker.epollFd, events, maxEvents, -1);
+        for (int i = 0; i < numEvents; i++) {
+            void* source = events[i].data.ptr;
+            if (source == &stopFd) {
+                isStopping = true;
+            } else if (source == &worker.wakeFd) {
+                addNewConnections(worker);
+            } else {
+                Connection* connection = (Connection*)source;
+                bool isOpen = true;
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                    isOpen = readRequests(*connection);
+                }
+                if (isOpen) {
+                    isOpen = writeResponses(worker, *connection);
+                }
+                if (!isOpen) {
+                    closeConnection(worker, connection);
+                }
+            }
+        }
+    }
+
+    for (Connection* connection : worker.connections) {
+        close(connection->fd);
+        delete connection;
+    }
+    worker.connections.clear();
+}
+
+void GameServer::addNewConnections(Worker &worker) {
+    uint64_t count;
+    ssize_t result = read(worker.wakeFd, &count, sizeof(count));
+    (void)result;
+
+    lock_guard<mutex> guard(worker.lock);
+    for (Connection* connection : worker.newConnections) {
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.ptr = connection;
+        epoll_ctl(worker.epollFd, EPOLL_CTL_ADD, connection->fd, &event);
+        worker.connections.push_back(connection);
+    }
+    worker.newConnections.clear();
+}
+
+// Reads what has arrived and answers every complete line, until the output passes maxOutputLength
+// (the rest is read once the client takes some). Returns false if the client has gone.
+// A client that closes its end still gets the answers to what it sent.
+bool GameServer::readRequests(Connection &connection) {
+    char buffer[4096];
+    while (connection.output.length() < maxOutputLength) {
+        ssize_t numRead = read(connection.fd, buffer, sizeof(buffer));
+        if (numRead == 0) {
+            connection.isClosing = true;
+            return !connection.output.empty();
+        }
+        if (numRead < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        // Nothing more is read from a client that is being closed.
+        if (connection.isClosing) {
+            continue;
+        }
+        connection.input.append(buffer, numRead);
+
+        size_t lineStart = 0;
+        size_t lineEnd;
+        while (!connection.isClosing && (lineEnd = connection.input.find('\n', lineStart)) != string::npos) {
+            size_t length = lineEnd - lineStart;
+            if (length > 0 && connection.input[lineEnd - 1] == '\r') {
+                length--;
+            }
+            string response;
+            connection.isClosing = !connection.session.handle(connection.input.substr(lineStart, length), response);
+            connection.output += response;
+            connection.output += '\n';
+            numRequests++;
+            lineStart = lineEnd + 1;
+        }
+        connection.input.erase(0, lineStart);
+
+        if (connection.input.length() > maxLineLength) {
+            connection.output += "ERR The request is too long.\n";
+            connection.isClosing = true;
+        }
+    }
+    return true;
+}
+
+// Writes as much of the output as the socket takes, waiting for EPOLLOUT if it's full.
+// Returns false once a closing connection has written everything (or the write fails).
+bool GameServer::writeResponses(Worker &worker, Connection &connection) {
+    size_t written = 0;
+    while (written < connection.output.length()) {
+        // MSG_NOSIGNAL: a client that has gone returns an error instead of raising SIGPIPE.
+        ssize_t result = send(connection.fd, connection.output.data() + written,
+                              connection.output.length() - written, MSG_NOSIGNAL);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return false;
+            }
+            break;
+        }
+        written += result;
+    }
+    connection.output.erase(0, written);
+
+    // Reading stops while the output is full or the connection is closing, so a client that sends
+    // without reading the answers (or has closed its end) doesn't keep the loop busy.
+    bool isWaiting = !connection.output.empty();
+    bool isReading = !connection.isClosing && connection.output.length() < maxOutputLength;
+    uint32_t events = (isReading ? EPOLLIN : 0) | (isWaiting ? EPOLLOUT : 0);
+    if (events != connection.events) {
+        epoll_event event = {};
+        event.events = events;
+        event.data.ptr = &connection;
+        epoll_ctl(worker.epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.events = events;
+    }
+    return isWaiting || !connection.isClosing;
+}
+
+void GameServer::closeConnection(Worker &worker, Connection* connection) {
+    epoll_ctl(worker.epollFd, EPOLL_CTL_DEL, connection->fd, nullptr);
+    close(connection->fd);
+    worker.connections.erase(find(worker.connections.begin(), worker.connections.end(), connection));
+    delete connection;
+}
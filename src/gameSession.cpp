@@ -0,0 +1,183 @@
+#include "../include/gameSession.hpp"
+#include <exception>
+#include <sstream>
+using namespace std;
+
+GameSession::GameSession(GamePool &pool) : pool(pool) {
+    game = nullptr;
+    hasShots = false;
+}
+
+// Deconstructor returns the current game to the pool.
+GameSession::~GameSession() {
+    pool.release(game);
+}
+
+bool GameSession::handle(const string &request, string &response) {
+    istringstream words(request);
+    string command;
+    words >> command;
+    response = "OK";
+
+    try {
+        if (command == "NEW") {
+            int numPlayers = 0;
+            string seedText;
+            string engineName = "approximate";
+            int endgameThreshold = 0;
+            words >> numPlayers >> seedText >> engineName >> endgameThreshold;
+            if (numPlayers < 1 || numPlayers > 2) {
+                throw logic_error("The number of players must be 1 or 2.");
+            }
+            DensityEngine engine;
+            if (!BattleshipCPU::getEngine(engineName, engine)) {
+                throw logic_error("Unknown engine '" + engineName + "'.");
+            }
+            bool isSeeded = !seedText.empty() && seedText != "random";
+            uint64_t seed = isSeeded ? stoull(seedText) : 0;
+            if (endgameThreshold < 0 || endgameThreshold > EndgameSolver::maxThreshold) {
+                throw logic_error("The endgame threshold must be from 0 to " + to_string(EndgameSolver::maxThreshold) + ".");
+            }
+            newGame(numPlayers, isSeeded, seed, engine, endgameThreshold);
+        } else if (command == "BOARD") {
+            int player = 0;
+            string layout;
+            words >> player >> layout;
+            if (!game) {
+                throw logic_error("No game, start one with NEW.");
+            }
+            if (player < 1 || player > 2) {
+                throw logic_error("The player must be 1 or 2.");
+            }
+            if (hasShots) {
+                throw logic_error("The ships can't be moved after the first shot.");
+            }
+            game->setBoardLayout(player, layout);
+        } else if (command == "SHOOT") {
+            string coordinate;
+            words >> coordinate;
+            shoot(coordinate, response);
+        } else if (command == "STATE") {
+            if (!game) {
+                throw logic_error("No game, start one with NEW.");
+            }
+            addState(response);
+        } else if (command == "METRICS") {
+            string scope;
+            words >> scope;
+            ostringstream json;
+            if (scope == "GAME") {
+                if (!game) {
+                    throw logic_error("No game, start one with NEW.");
+                }
+                Metrics::writeJson(json, game->getMetrics());
+            } else {
+                Metrics::writeJson(json, Metrics::getProcessMetrics());
+            }
+            response += ' ' + json.str();
+        } else if (command == "QUIT") {
+            return false;
+        } else {
+            throw logic_error("Unknown command '" + command + "'.");
+        }
+    } catch (exception &e) {
+        // Both logic and runtime errors (bad input, invalid layouts) are reported to the client.
+        response = string("ERR ") + e.what();
+    }
+    return true;
+}
+
+void GameSession::newGame(int numPlayers, bool isSeeded, uint64_t seed, DensityEngine engine, int endgameThreshold) {
+    pool.release(game);
+    game = pool.acquire(numPlayers);
+    if (numPlayers == 1) {
+        BattleshipCPU* cpuGame = static_cast<BattleshipCPU*>(game);
+        cpuGame->setDensityEngine(engine);
+        cpuGame->setEndgameThreshold(endgameThreshold); // Pooled games keep the last one.
+    }
+    game->setOutputLevel(QUIET_OUTPUT);
+    if (isSeeded) {
+        game->setSeed(seed);
+    }
+    game->startGame(numPlayers, false, false);
+    hasShots = false;
+}
+
+// Takes the current player's shot (and the CPU's reply), like a turn of the interactive game.
+void GameSession::shoot(const string &coordinate, string &response) {
+    if (!game) {
+        throw logic_error("No game, start one with NEW.");
+    }
+    if (game->isGameFinished()) {
+        throw logic_error("The game is over.");
+    }
+
+    char x;
+    int y;
+    Battleship::parseCoordinate(coordinate, x, y);
+    int shooter = game->getCurrPlayer();
+    game->shoot(x, y);
+    hasShots = true;
+    addLastShot(game->getBoard((shooter == 1) ? 2 : 1), response);
+
+    if (game->getNumPlayers() == 1) {
+        BattleshipCPU* cpuGame = static_cast<BattleshipCPU*>(game);
+        cpuGame->cpuShoot();
+        int cpuMove = cpuGame->getLastMove();
+        response += ' ';
+        response += char('A' + (cpuMove % 10));
+        response += to_string((cpuMove / 10) + 1);
+        addLastShot(game->getBoard(1), response);
+    }
+
+    // The game is checked once both players have shot, so it can end in a draw.
+    if (game->getCurrPlayer() == 1 && (game->isP1Win() || game->isP2Win())) {
+        game->setGameFinished(true);
+        addStatus(response);
+    }
+}
+
+// Adds the current player, the status and both boards.
+void GameSession::addState(string &response) {
+    response += ' ';
+    response += to_string(game->getCurrPlayer());
+    if (game->isGameFinished()) {
+        addStatus(response);
+    } else {
+        response += " PLAYING";
+    }
+
+    for (int player = 1; player <= 2; player++) {
+        Board &board = game->getBoard(player);
+        // Like showBoard, a player's own ships are only shown against the CPU.
+        bool isVisible = (player == 1) && (game->getNumPlayers() == 1);
+        response += ' ';
+        for (int i = 0; i < 10; i++) {
+            for (int j = 0; j < 10; j++) {
+                response += (isVisible || board.isPosHit(j, i)) ? board.getPiece(j, i) : Board::emptySpace;
+            }
+        }
+    }
+}
+
+void GameSession::addStatus(string &response) {
+    if (game->isP1Win() && game->isP2Win()) {
+        response += " WIN DRAW";
+    } else {
+        response += game->isP1Win() ? " WIN 1" : " WIN 2";
+    }
+}
+
+// Adds what the last shot at the board hit.
+void GameSession::addLastShot(Board &board, string &response) {
+    int cell = board.getShot(board.getNumShots() - 1);
+    Bitboard target = Bitboard::cell(cell);
+    for (int i = 0; i < Fleet::numShips; i++) {
+        if ((board.getShipMask(i) & target).any()) {
+            response += board.isShipSunk(i) ? " SUNK " : " HIT ";
+            response += Fleet::ships[i].type;
+            return;
+        }
+    }
+    response += " MISS";
+}
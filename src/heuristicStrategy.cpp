@@ -0,0 +1,471 @@
+#include "../include/heuristicStrategy.hpp"
+#include "../include/densityKernel.hpp"
+#include "../include/metrics.hpp"
+using namespace std;
+
+// Starts a new game against the board.
+void HeuristicStrategy::reset(Board &board) {
+    resetDensity(board);
+    densityOutdated = true;
+    sinkMode = false;
+    prevShipHit = 0;
+    for (int i = 0; i < Fleet::numShips; i++) {
+        shipPosFound[i].clear();
+        isShipFound[i] = false;
+        cpuMoves[i].clear();
+        hasCpuMoves[i] = false;
+    }
+    numShipsWithMoves = 0;
+}
+
+// Gets a move from the endgame solver once few fleets are left, otherwise from the queued
+// moves if there are any, otherwise from the density.
+Coordinate HeuristicStrategy::chooseMove() {
+    Coordinate endgameMove(-1, -1);
+    if (chooseEndgameMove(endgameMove)) {
+        return endgameMove;
+    }
+    if (numShipsWithMoves > 0) {
+        return getCpuMove();
+    }
+    return getNextMove();
+}
+
+// Updates target mode and the density after a shot.
+// The density is recalculated when it's next needed (a hunt move, or ordering the neighbours of
+// a new hit), not while sinking a ship. A pass of DensityKernel costs less than recalculating
+// the positions in line with the shot.
+void HeuristicStrategy::recordShot(int x, int y, ShotResult result, int shipId) {
+    densityOutdated = true;
+    switch (result) {
+        case SHOT_MISS:
+            // If there is a ship that has been hit (but not sunk),
+            // then push the remaining moves to sink it.
+            if (sinkMode) {
+                backTrackShot(x, y);
+            }
+            break;
+        case SHOT_SUNK:
+            // Remove the ship from target mode.
+            clearShipMoves(shipId);
+            // Sets the next previous ship to sink.
+            setPrevShip();
+            sinkMode = false;
+            // The remaining ships (and parity) have changed.
+            recordSunk(shipId);
+            break;
+        case SHOT_HIT:
+            setCpuMoves(x, y, shipId);
+            break;
+        default:
+            break;
+    }
+}
+
+// Calculate the probability of each position holding an unsunk ship (see DensityKernel).
+void HeuristicStrategy::calculateProbability() {
+    numLiveShips = 0;
+    for (int i = 0; i < Fleet::numShips; i++) {
+        if (!board->isShipSunk(i)) {
+            liveShipLengths[numLiveShips++] = Fleet::getLength(i);
+        }
+    }
+
+    Bitboard open = ~board->getShots() & Bitboard::full();
+    METRIC_ADD(PROBABILITY_PASSES, 1);
+    METRIC_ADD(PROBABILITY_CELLS, open.count());
+    DensityKernel::calculate(open, liveShipLengths, numLiveShips, probBoard);
+    densityOutdated = false;
+}
+
+// Gets the move with the highest density probability.
+Coordinate HeuristicStrategy::getNextMove() {
+    if (densityOutdated) {
+        calculateProbability();
+    }
+    return chooseDensityMove(&probBoard[0][0]);
+}
+
+// Gets a move used to hunt down a discovered ship.
+// Stale moves (already hit, or where the ship can't fit) are skipped in a bounded loop, and an
+// empty queue is refilled once from the ship's hits. Falls back to the density if nothing is left.
+Coordinate HeuristicStrategy::getCpuMove() {
+#ifndef BATTLESHIP_NO_METRICS
+    int numQueued = 0;
+    for (int i = 0; i < Fleet::numShips; i++) {
+        numQueued += cpuMoves[i].size();
+    }
+    METRIC_ADD(CPU_MOVE_CALLS, 1);
+    METRIC_ADD(CPU_MOVES_QUEUED, numQueued);
+    METRIC_MAX(CPU_MOVE_MAX_QUEUED, numQueued);
+#endif
+
+    for (int check = 0; check < maxMoveChecks && numShipsWithMoves > 0; check++) {
+        METRIC_MAX(CPU_MOVE_MAX_DEPTH, check + 1);
+        // Get possible moves for a damaged, but unsunk ship.
+        int shipId = getFirstShip(hasCpuMoves);
+        MoveQueue &shipMoves = cpuMoves[shipId];
+
+        // If there are no moves, then push the moves to sink it.
+        if (shipMoves.empty()) {
+            METRIC_ADD(CPU_MOVE_REFILLS, 1);
+            // setAltMoves() needs this.
+            prevShipHit = shipId;
+            Coordinate first = toCoordinate(shipPosFound[shipId].front());
+            Coordinate last = toCoordinate(shipPosFound[shipId].back());
+            // Direction of the ship being shot before going on another ship.
+            setAltMoves(getDirection(last, first), last);
+            sinkMode = true;
+
+            // The remaining positions can't be reached from these hits, so stop targeting it.
+            if (shipMoves.empty()) {
+                hasCpuMoves[shipId] = false;
+                numShipsWithMoves--;
+                sinkMode = false;
+            }
+            continue;
+        }
+
+        Coordinate nextMove = toCoordinate(shipMoves.front());
+        shipMoves.pop();
+
+        // Another ship's moves may have hit it since it was queued.
+        if (board->isPosHit(nextMove.getX(), nextMove.getY())) {
+            METRIC_ADD(CPU_MOVE_RETRIES, 1);
+            continue;
+        }
+
+        // If the CPU is trying to find the ship's position, skip directions it can't lie in.
+        if (!sinkMode) {
+            Coordinate prevMove = toCoordinate(shipPosFound[shipId].front());
+            Direction dir = getDirection(prevMove, nextMove);
+            if (!canShipExist(Fleet::getLength(shipId), prevMove, dir)) {
+                METRIC_ADD(CPU_MOVE_RETRIES, 1);
+                continue;
+            }
+        }
+        return nextMove;
+    }
+    METRIC_ADD(CPU_MOVE_FALLBACKS, 1);
+    return getNextMove();
+}
+
+// Sets the possible moves for the CPU after a ship is hit.
+void HeuristicStrategy::setCpuMoves(int x, int y, int shipId) {
+    // If the ship hasn't been found, try and find the ship's direction.
+    if (!isShipFound[shipId]) {
+        findShip(x, y, shipId);
+        sinkMode = false;
+    // Otherwise, push the coordinates into the existing queues (to sink the ship).
+    } else {
+        sinkShip(x, y, shipId);
+        sinkMode = true;
+    }
+}
+
+// Pushes in moves that are used to find a ship's direction.
+void HeuristicStrategy::findShip(int x, int y, int shipId) {
+    // Create hit position queue (positions hit on the ship).
+    shipPosFound[shipId].clear();
+    shipPosFound[shipId].push((y * 10) + x);
+    isShipFound[shipId] = true;
+
+    // Create possible moves queue.
+    MoveQueue &possibleMoves = getCpuMoves(shipId);
+    possibleMoves.clear();
+
+    bool upPlaced = false;
+    bool downPlaced = false;
+    bool leftPlaced = false;
+    bool rightPlaced = false;
+
+    // The neighbours are ordered by the density with this hit.
+    if (densityOutdated) {
+        calculateProbability();
+    }
+
+    // Set probability to -1 if the position is out of bounds.
+    int upProb = (y > 0) && !board->isPosHit(x, y - 1) ? probBoard[y - 1][x] : -1;
+    int downProb = (y < 9) && !board->isPosHit(x, y + 1) ? probBoard[y + 1][x] : -1;
+    int leftProb = (x > 0) && !board->isPosHit(x - 1, y) ? probBoard[y][x - 1] : -1;
+    int rightProb = (x < 9) && !board->isPosHit(x + 1, y) ? probBoard[y][x + 1] : -1;
+
+    // Adds positions around where the ship was hit (in descending order of probability).
+    // We don't know where the ship is positioned at this point.
+    while (!upPlaced || !downPlaced || !leftPlaced || !rightPlaced) {
+        int maxVerti = (upProb > downProb) ? upProb : downProb;
+        int maxHoriz = (leftProb > rightProb) ? leftProb : rightProb;
+        int currMax = (maxVerti > maxHoriz) ? maxVerti : maxHoriz;
+
+        // UP.
+        if (y > 0 && !board->isPosHit(x, y - 1) && !upPlaced) {
+            if (upProb == currMax) {
+                possibleMoves.push(((y - 1) * 10) + x);
+                upPlaced = true;
+                upProb = -1;
+            }
+        } else {
+            // Even if it's not valid. Indicate that it has been checked.
+            upPlaced = true;
+        }
+
+        // DOWN.
+        if (y < 9 && !board->isPosHit(x, y + 1) && !downPlaced) {
+            if (downProb == currMax) {
+                possibleMoves.push(((y + 1) * 10) + x);
+                downPlaced = true;
+                downProb = -1;
+            }
+        } else {
+            downPlaced = true;
+        }
+
+        // LEFT.
+        if (x > 0 && !board->isPosHit(x - 1, y) && !leftPlaced) {
+            if (leftProb == currMax) {
+                possibleMoves.push((y * 10) + x - 1);
+                leftPlaced = true;
+                leftProb = -1;
+            }
+        } else {
+            leftPlaced = true;
+        }
+
+        // RIGHT.
+        if (x < 9 && !board->isPosHit(x + 1, y) && !rightPlaced) {
+            if (rightProb == currMax) {
+                possibleMoves.push((y * 10) + x + 1);
+                rightPlaced = true;
+                rightProb = -1;
+            }
+        } else {
+            rightPlaced = true;
+        }
+    }
+}
+
+// Push in moves that are used to sink a ship.
+void HeuristicStrategy::sinkShip(int x, int y, int shipId) {
+    //Adjust cpuMoves.
+    MoveQueue &currMoves = getCpuMoves(shipId);
+
+    // If the ship was hit once previously, then remove the blank moves (for this ship).
+    if (shipPosFound[shipId].size() == 1)
+        currMoves.clear();
+
+    Coordinate prevShipMove = toCoordinate(shipPosFound[shipId].back());
+    Coordinate currShipMove(x, y);
+    shipPosFound[shipId].push((y * 10) + x);
+
+    prevShipHit = shipId; // Used if backtracking is needed.
+
+    // Get the direction in respect with the previously hit position.
+    Direction dir = getDirection(currShipMove, prevShipMove);
+
+    switch(dir) {
+        case UP:
+            // Continue the direction if it's still in bounds and 
+            // if the next position hasn't been hit.
+            if (y > 0 && !board->isPosHit(x, y - 1)) {
+                currMoves.push(((y - 1) * 10) + x);
+            } else {
+                // Otherwise, set moves to sink the ship.
+                setAltMoves(UP, currShipMove);
+            }
+            break;
+        case DOWN:
+            if (y < 9 && !board->isPosHit(x, y + 1)) {
+                currMoves.push(((y + 1) * 10) + x);
+            } else {
+                setAltMoves(DOWN, currShipMove);
+            }
+            break;
+        case LEFT:
+            if (x > 0 && !board->isPosHit(x - 1, y)) {
+                currMoves.push((y * 10) + x - 1);
+            } else {
+                setAltMoves(LEFT, currShipMove);
+            }
+            break;
+        case RIGHT:
+            if (x < 9 && !board->isPosHit(x + 1, y)) {
+                currMoves.push((y * 10) + x + 1);
+            } else {
+                setAltMoves(RIGHT, currShipMove);
+            }
+            break;
+    }
+}
+
+// Adjusts the possible moves when missing a shot while trying to sink a ship.
+void HeuristicStrategy::backTrackShot(int x, int y) {
+    Coordinate prevShipMove = toCoordinate(shipPosFound[prevShipHit].back());
+
+    // Get direction, then push in remaining moves to sink the ship.
+    Direction dir = getDirection(Coordinate(x, y), prevShipMove);
+    setAltMoves(dir, prevShipMove);
+}
+
+// Sets the moves to sink a discovered ship.
+void HeuristicStrategy::setAltMoves(Direction dir, Coordinate prevShipMove) {
+    MoveQueue &currMoves = getCpuMoves(prevShipHit);
+
+    int x = prevShipMove.getX();
+    int y = prevShipMove.getY();
+
+    // Used to determine new moves.
+    int timesHit = shipPosFound[prevShipHit].size(); // Could use length - health...
+    int health = board->getShipHealth(prevShipHit);
+
+    // Only consider ships with length 3 or more (A patrol boat would've been sunk already).
+    switch (dir) {
+        // If you went Up, go Down.
+        case UP:
+            // Based on the ship's remaining health (it has been hit at least TWICE).
+            switch (health) {
+                case 3:
+                    pushMoveIfValid(currMoves, x, y + (timesHit + 2));
+                    [[fallthrough]];
+                case 2:
+                    pushMoveIfValid(currMoves, x, y + (timesHit + 1));
+                    [[fallthrough]];
+                case 1:
+                    pushMoveIfValid(currMoves, x, y + timesHit);
+            }
+            break;
+        // If you went Down, go Up.
+        case DOWN:
+            switch (health) {
+                case 3:
+                    pushMoveIfValid(currMoves, x, y - (timesHit + 2));
+                    [[fallthrough]];
+                case 2:
+                    pushMoveIfValid(currMoves, x, y - (timesHit + 1));
+                    [[fallthrough]];
+                case 1:
+                    pushMoveIfValid(currMoves, x, y - timesHit);
+            }
+            break;
+        // If you went Left, go Right.  
+        case LEFT:
+            switch (health) {
+                case 3:
+                    pushMoveIfValid(currMoves, x + (timesHit + 2), y);
+                    [[fallthrough]];
+                case 2:
+                    pushMoveIfValid(currMoves, x + (timesHit + 1), y);
+                    [[fallthrough]];
+                case 1:
+                    pushMoveIfValid(currMoves, x + timesHit, y);
+            }
+            break;
+        // If you went Right, go Left.
+        case RIGHT:
+            switch (health) {
+                case 3:
+                    pushMoveIfValid(currMoves, x - (timesHit + 2), y);
+                    [[fallthrough]];
+                case 2:
+                    pushMoveIfValid(currMoves, x - (timesHit + 1), y);
+                    [[fallthrough]];
+                case 1:
+                    pushMoveIfValid(currMoves, x - timesHit, y);
+            }
+            break;
+    }
+}
+
+// Only queues a move that is on the board and hasn't been hit yet.
+void HeuristicStrategy::pushMoveIfValid(MoveQueue &moves, int x, int y) {
+    if (x >= 0 && x <= 9 && y >= 0 && y <= 9 && !board->isPosHit(x, y)) {
+        moves.push((y * 10) + x);
+    }
+}
+
+// Sets the new previous ship, once a ship has sunk.
+void HeuristicStrategy::setPrevShip() {
+    // Fetch a found ship (the first in fleet order).
+    int shipId = getFirstShip(isShipFound);
+    if (shipId >= 0) {
+        prevShipHit = shipId;
+
+        // Push moves to sink the unsunk ship.
+        if (getCpuMoves(shipId).empty()) {
+            Coordinate prevMove = toCoordinate(shipPosFound[shipId].back());
+            Coordinate firstMove = toCoordinate(shipPosFound[shipId].front());
+            Direction dir = getDirection(prevMove, firstMove);
+            setAltMoves(dir, prevMove);
+        }
+    }
+}
+
+// Returns a ship's moves, and marks it as having moves (even if there are none yet).
+MoveQueue& HeuristicStrategy::getCpuMoves(int shipId) {
+    if (!hasCpuMoves[shipId]) {
+        hasCpuMoves[shipId] = true;
+        cpuMoves[shipId].clear();
+        numShipsWithMoves++;
+    }
+    return cpuMoves[shipId];
+}
+
+// Removes a ship from target mode.
+void HeuristicStrategy::clearShipMoves(int shipId) {
+    if (hasCpuMoves[shipId]) {
+        hasCpuMoves[shipId] = false;
+        numShipsWithMoves--;
+    }
+    isShipFound[shipId] = false;
+    shipPosFound[shipId].clear();
+    cpuMoves[shipId].clear();
+}
+
+// Returns the first ship in fleet order with its flag set (or -1), so the choice is always the same.
+int HeuristicStrategy::getFirstShip(const bool shipFlags[Fleet::numShips]) {
+    for (int i = 0; i < Fleet::numShips; i++) {
+        if (shipFlags[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Returns a direction based on two coordinates of a ship.
+Direction HeuristicStrategy::getDirection(Coordinate first, Coordinate last) {
+    int x = first.getX();
+    int y = first.getY();
+    int prevX = last.getX();
+    int prevY = last.getY();
+    Direction dir = UP; // The same position has no direction.
+
+    // Check and set direction.
+    if (y < prevY) {
+        dir = UP;
+    } else if (y > prevY) {
+        dir = DOWN;
+    } else if (x < prevX) {
+        dir = LEFT;
+    } else if (x > prevX) {
+        dir = RIGHT;
+    }
+    return dir;
+}
+
+// Checks if a ship's existence is possible in a given direction.
+bool HeuristicStrategy::canShipExist(int shipLength, Coordinate currPos, Direction dir) {
+    int x = currPos.getX();
+    int y = currPos.getY();
+    bool isVertical = (dir == UP || dir == DOWN);
+    Bitboard currCell = Bitboard::cell(x, y);
+
+    // Try every placement in that line that covers the current position (which is already hit).
+    for (int i = 0; i < shipLength; i++) {
+        if (isVertical && board->isSegmentFree(x, y - i, DOWN, shipLength, currCell)) {
+            return true;
+        }
+        if (!isVertical && board->isSegmentFree(x - i, y, RIGHT, shipLength, currCell)) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,119 @@
+#include "../include/layoutBank.hpp"
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+using namespace std;
+
+LayoutBank::LayoutBank() { }
+
+// Deconstructor.
+LayoutBank::~LayoutBank() { }
+
+void LayoutBank::add(const ShipLayout &fleet, double score) {
+    int rank = 0;
+    while (rank < int(layouts.size()) && layouts[rank].score >= score) {
+        rank++;
+    }
+    layouts.insert(layouts.begin() + rank, {fleet, score});
+    for (int i = 0; i < numSymmetries; i++) {
+        variants.push_back(transform(fleet, i));
+    }
+}
+
+// Every layout and symmetry has the same chance, and nothing is allocated.
+void LayoutBank::draw(FastRandom &random, Board &board) const {
+    const ShipLayout &fleet = variants[random.nextBelow(variants.size())];
+    for (int i = 0; i < Fleet::numShips; i++) {
+        board.placeShip(i, fleet.ships[i]);
+    }
+}
+
+bool LayoutBank::load(string fileName) {
+    ifstream bankFile(fileName);
+    if (!bankFile.is_open()) {
+        return false;
+    }
+
+    string line;
+    int lineNum = 0;
+    while (getline(bankFile, line)) {
+        lineNum++;
+        if (line.empty()) {
+            continue;
+        }
+        istringstream words(line);
+        double score;
+        string pieces;
+        if (!(words >> score >> pieces) || pieces.length() != 100) {
+            throw runtime_error(fileName + ", line " + to_string(lineNum) + ": expected a score and 100 pieces.");
+        }
+
+        ShipLayout fleet;
+        for (int cell = 0; cell < 100; cell++) {
+            int shipId = Board::getShipId(pieces[cell]);
+            if (shipId >= 0) {
+                fleet.ships[shipId] |= Bitboard::cell(cell);
+            } else if (pieces[cell] != Board::emptySpace) {
+                throw runtime_error(fileName + ", line " + to_string(lineNum) + ": invalid piece '" + pieces[cell] + "'.");
+            }
+        }
+        int shipId;
+        LayoutError error = LayoutValidator::validate(fleet.ships, shipId);
+        if (error != LAYOUT_OK) {
+            throw runtime_error(fileName + ", line " + to_string(lineNum) + ": " + LayoutValidator::getMessage(error));
+        }
+        add(fleet, score);
+    }
+    return true;
+}
+
+void LayoutBank::save(string fileName) const {
+    ofstream bankFile(fileName);
+    if (!bankFile.is_open()) {
+        throw runtime_error("The layout bank '" + fileName + "' cannot be written.");
+    }
+    bankFile << fixed << setprecision(3);
+    for (const BankLayout &layout : layouts) {
+        bankFile << layout.score << ' ' << getLayoutText(layout.fleet) << endl;
+    }
+}
+
+string LayoutBank::getLayoutText(const ShipLayout &fleet) {
+    string pieces(100, Board::emptySpace);
+    for (int i = 0; i < Fleet::numShips; i++) {
+        Bitboard mask = fleet.ships[i];
+        while (mask.any()) {
+            pieces[mask.lowest()] = Fleet::ships[i].type;
+            mask.popLowest();
+        }
+    }
+    return pieces;
+}
+
+ShipLayout LayoutBank::transform(const ShipLayout &fleet, int symmetry) {
+    ShipLayout turned;
+    for (int i = 0; i < Fleet::numShips; i++) {
+        Bitboard mask = fleet.ships[i];
+        while (mask.any()) {
+            turned.ships[i] |= Bitboard::cell(transformCell(mask.lowest(), symmetry));
+            mask.popLowest();
+        }
+    }
+    return turned;
+}
+
+// Symmetries 0 to 3 turn the board by 0, 90, 180 and 270 degrees, 4 to 7 do the same after a mirror.
+int LayoutBank::transformCell(int cell, int symmetry) {
+    int x = cell % 10;
+    int y = cell / 10;
+    if (symmetry >= 4) {
+        x = 9 - x;
+    }
+    for (int i = 0; i < symmetry % 4; i++) {
+        int prevX = x;
+        x = 9 - y;
+        y = prevX;
+    }
+    return (y * 10) + x;
+}
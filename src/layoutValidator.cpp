@@ -0,0 +1,81 @@
+#include "../include/layoutValidator.hpp"
+
+// Moves a pattern in the low bits up to start (bits past the end are lost).
+static inline Bitboard shiftFrom(uint64_t pattern, int start) {
+    if (start == 0) {
+        return Bitboard(pattern, 0);
+    }
+    return (start < 64) ? Bitboard(pattern << start, pattern >> (64 - start)) : Bitboard(0, pattern << (start - 64));
+}
+
+LayoutError LayoutValidator::validateShip(Bitboard mask, int shipId) {
+    if (mask.empty()) {
+        return LAYOUT_MISSING_SHIP;
+    }
+    if ((mask & ~Bitboard::full()).any()) {
+        return LAYOUT_OFF_BOARD;
+    }
+    if (mask.count() != Fleet::getLength(shipId)) {
+        return LAYOUT_WRONG_LENGTH;
+    }
+    // The right number of positions, so it's valid if it's the run going right or down from its first position.
+    int start = mask.lowest();
+    int length = Fleet::getLength(shipId);
+    uint64_t across = (uint64_t(1) << length) - 1;
+    uint64_t down = 0x10040100401ULL & ((uint64_t(1) << (10 * (length - 1) + 1)) - 1); // Every 10th bit.
+    bool isStraight = (start % 10 + length <= 10 && mask == shiftFrom(across, start)) || mask == shiftFrom(down, start);
+    return isStraight ? LAYOUT_OK : LAYOUT_NOT_STRAIGHT;
+}
+
+LayoutError LayoutValidator::validate(const Bitboard ships[Fleet::numShips], int &shipId) {
+    Bitboard occupied;
+    for (int i = 0; i < Fleet::numShips; i++) {
+        LayoutError error = validateShip(ships[i], i);
+        if (error == LAYOUT_OK && (occupied & ships[i]).any()) {
+            error = LAYOUT_OVERLAP;
+        }
+        if (error != LAYOUT_OK) {
+            shipId = i;
+            return error;
+        }
+        occupied |= ships[i];
+    }
+    shipId = -1;
+    return LAYOUT_OK;
+}
+
+LayoutError LayoutValidator::validate(Board &board) {
+    Bitboard ships[Fleet::numShips];
+    for (int i = 0; i < Fleet::numShips; i++) {
+        ships[i] = board.getShipMask(i);
+    }
+    int shipId;
+    return validate(ships, shipId);
+}
+
+size_t LayoutValidator::validateBatch(const ShipLayout* layouts, size_t count, LayoutError* errors) {
+    size_t numValid = 0;
+    for (size_t i = 0; i < count; i++) {
+        int shipId;
+        errors[i] = validate(layouts[i].ships, shipId);
+        numValid += errors[i] == LAYOUT_OK;
+    }
+    return numValid;
+}
+
+string LayoutValidator::getMessage(LayoutError error) {
+    switch (error) {
+        case LAYOUT_MISSING_SHIP:
+            return "a ship is missing";
+        case LAYOUT_OFF_BOARD:
+            return "a ship is off the board";
+        case LAYOUT_WRONG_LENGTH:
+            return "a ship is the wrong length";
+        case LAYOUT_NOT_STRAIGHT:
+            return "a ship isn't in a straight line";
+        case LAYOUT_OVERLAP:
+            return "ships overlap";
+        default:
+            return "valid";
+    }
+}
@@ -1,5 +1,9 @@
 #include "../include/battleship.hpp"
-#include "../include/battleshipCPU.hpp"
+#include "../include/battleshipCpu.hpp"
+#include "../include/gameArchive.hpp"
+#include "../include/batchDriver.hpp"
+#include "../include/gamePool.hpp"
+#include "../include/layoutBank.hpp"
 #include <iostream>
 #include <exception>
 using namespace std;
@@ -8,44 +12,76 @@ void setNumPlayers(int&);
 void setFileOptions(int, bool&, bool&);
 void runGame(Battleship*);
 void checkGameStatus(Battleship*);
-void playAgain(void);
+void archiveGame(Battleship*);
+bool playAgain(void);
+int runScript(int, char*[]);
 
 // DRIVER CODE.
-int main(void) {
-    cout << "-----------------------Battleship---------------------" << endl;
-    
-    // Ask for the number of players.
-    int numPlayers;
-    setNumPlayers(numPlayers);
+// With -s scriptFile (or - for stdin), the games are read from a script instead (see BatchDriver).
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        return runScript(argc, argv);
+    }
+
+    GamePool games; // Reused from one game to the next.
+
+    // The CPU's fleet is drawn from layouts that are hard to find, if they've been made (see tools/optimize.cpp).
+    LayoutBank layoutBank;
+    try {
+        layoutBank.load("../layouts.bank");
+    } catch (runtime_error &e) {
+        cout << "Error: " << e.what() << endl;
+    }
+
+    bool isPlaying = true;
+    while (isPlaying) {
+        cout << "-----------------------Battleship---------------------" << endl;
+
+        // Ask for the number of players.
+        int numPlayers;
+        setNumPlayers(numPlayers);
+
+        // Asks the user if they want to read their ship placements from their file.
+        bool loadP1ShipFile = false;
+        bool loadP2ShipFile = false;
+        setFileOptions(numPlayers, loadP1ShipFile, loadP2ShipFile);
+
+        // Initialise the game.
+        Battleship* myGame = games.acquire(numPlayers);
+        myGame->setLayoutBank(&layoutBank);
+
+        // Restart the game if the file can't be found (if they choose to use it).
+        try {
+            myGame->startGame(numPlayers, loadP1ShipFile, loadP2ShipFile);
+        } catch (runtime_error &e) {
+            cout << "Error: " << e.what() << endl;
+            cout << "Restarting game..." << endl;
+            games.release(myGame);
+            continue;
+        }
 
-    // Asks the user if they want to read their ship placements from their file.
-    bool loadP1ShipFile = false;
-    bool loadP2ShipFile = false;
-    setFileOptions(numPlayers, loadP1ShipFile, loadP2ShipFile);
+        // Run the game until completion.
+        runGame(myGame);
+        games.release(myGame);
+        isPlaying = playAgain();
+    }
+    return 0;
+}
 
-    // Initialise the game.
-    Battleship* myGame = nullptr;
-    if (numPlayers == 1) {
-        myGame = new BattleshipCPU();
-    } else {
-        myGame = new Battleship();
+// Plays the games in a script and reports how long each took.
+int runScript(int argc, char* argv[]) {
+    if (argc != 3 || string(argv[1]) != "-s") {
+        cout << "Usage: battleship [-s scriptFile]" << endl;
+        return 1;
     }
 
-    // Restart the game if the file can't be found (if they choose to use it).
     try {
-        myGame->startGame(numPlayers, loadP1ShipFile, loadP2ShipFile);
-    } catch (runtime_error e) {
+        BatchDriver driver;
+        driver.run(BatchDriver::readScript(argv[2]), cout);
+    } catch (runtime_error &e) {
         cout << "Error: " << e.what() << endl;
-        cout << "Restarting game..." << endl;
-        // Delete current game object, then restart the game.
-        delete myGame;
-        main();
-        return 0;
+        return 1;
     }
-
-    // Run the game until completion.
-    runGame(myGame);
-    playAgain();
     return 0;
 }
 
@@ -88,7 +124,7 @@ void setNumPlayers(int &numPlayers) {
                 default:
                     throw logic_error("Too many players, it must be either 1 or 2.");
             }
-        } catch (logic_error e) {
+        } catch (logic_error &e) {
             cout << "Error: " << e.what() << endl;
         }
     }
@@ -129,7 +165,7 @@ void setFileOptions(int numPlayers, bool &loadP1ShipFile, bool &loadP2ShipFile)
                     default:
                         throw logic_error("Invalid option, enter Y or N.");
                 }
-            } catch (logic_error e) {
+            } catch (logic_error &e) {
                 cout << "Error: " << e.what() << endl;
             }
         }
@@ -160,52 +196,17 @@ void runGame(Battleship* myGame) {
             cout << "Enter the co-ordinates (e.g. A1): ";
             getline(cin, xy);
 
-            char x;
-            string strY;
-
             try {
-                // Check the length.
-                switch (xy.length()) {
-                    // If y is 10.
-                    case 3:
-                        strY = xy.substr(1,2);
-                        break;
-                    // If y is between 1 and 9.
-                    case 2:
-                        strY = xy[1];
-                        break;
-                    default:
-                        throw logic_error("Invalid co-ordinate length.");
-                }
-                
-                // Set x here (it's possible to input nothing).
-                x = toupper(xy[0]);
-
-                // Check if x is in range.
-                if (x < 'A' || x > 'J') {
-                    throw logic_error("The x-coordinate is out of range. Enter between A and J.");
-                }
-
-                // Check if the y-coordinates are integers.
-                for (char letter : strY) {
-                    if (letter < '0' || letter > '9') {
-                        throw logic_error("The y-coordinate must be in numbers.");
-                    }
-                }
-
-                // Convert y-coordinates to an integer, then check the range.
-                int y = stoi(strY);
-                if (y < 1 || y > 10) {
-                    throw logic_error("The y-coordinate is out of range. Enter between 1 and 10.");
-                }
-
+                char x;
+                int y;
+                Battleship::parseCoordinate(xy, x, y);
                 myGame->shoot(x, y);
                 // Run the CPU's turn if it's single player.
                 if (myGame->getNumPlayers() == 1) {
                     cout << endl << "----------------------CPU's Turn----------------------" << endl;
                     static_cast<BattleshipCPU*>(myGame)->cpuShoot();
                 }
-            } catch (logic_error e) {
+            } catch (logic_error &e) {
                 currPlayer--; // It will run the FOR loop again.
                 cout << "Error: " << e.what() << endl;
             }
@@ -213,8 +214,7 @@ void runGame(Battleship* myGame) {
         // Check the game's status after both player's turns.
         checkGameStatus(myGame);
     }
-    // Delete the game object after game completion.
-    delete myGame;
+    archiveGame(myGame);
 }
 
 // Check the game's status after both players have taken their turn.
@@ -255,37 +255,53 @@ void checkGameStatus(Battleship* myGame) {
     }
 }
 
-// Asks if the player wants to play again.
-void playAgain(void) {
-    string option;
-    cout << "Do you want to play again (Y/N)? ";
-    getline(cin, option);
-
+// Adds the finished game to the game archive (next to the boards folder).
+void archiveGame(Battleship* myGame) {
     try {
-        // Check input length.
-        if (option.length() > 1) {
-            throw logic_error("Invalid option, input is too long.");
-        } else if (option.length() == 0) {
-            throw logic_error("No option entered.");
+        ArchiveWriter archive;
+        archive.open("../games.bsa");
+        archive.write(GameArchive::makeRecord(*myGame));
+    } catch (runtime_error &e) {
+        cout << "Error: " << e.what() << endl;
+    }
+}
+
+// Asks if the player wants to play again (until a valid option is entered).
+bool playAgain(void) {
+    while (true) {
+        string option;
+        cout << "Do you want to play again (Y/N)? ";
+        getline(cin, option);
+
+        // Stop if the input has ended, instead of asking forever.
+        if (!cin) {
+            cout << "Terminating game..." << endl;
+            return false;
         }
 
-        // Check the option entered.
-        switch (option[0]) {
-            case 'N':
-            case 'n':
-                // Ends the program...
-                cout << "Terminating game..." << endl;
-                break;
-            case 'Y':
-            case 'y':
-               // Runs the main method again.
-                main();
-                break;
-            default:
-                throw logic_error("Invalid option, enter Y or N.");
+        try {
+            // Check input length.
+            if (option.length() > 1) {
+                throw logic_error("Invalid option, input is too long.");
+            } else if (option.length() == 0) {
+                throw logic_error("No option entered.");
+            }
+
+            // Check the option entered.
+            switch (option[0]) {
+                case 'N':
+                case 'n':
+                    // Ends the program...
+                    cout << "Terminating game..." << endl;
+                    return false;
+                case 'Y':
+                case 'y':
+                    return true;
+                default:
+                    throw logic_error("Invalid option, enter Y or N.");
+            }
+        } catch (logic_error &e) {
+            cout << "Error: " << e.what() << endl;
         }
-    } catch (logic_error e) {
-        cout << "Error: " << e.what() << endl;
-        playAgain(); 
-    }    
+    }
 }
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "../include/metrics.hpp"
+#include <mutex>
+using namespace std;
+
+#ifndef BATTLESHIP_NO_METRICS
+const bool Metrics::isEnabled = true;
+#else
+const bool Metrics::isEnabled = false;
+#endif
+
+static mutex processLock;
+static GameMetrics processMetrics;
+
+void GameMetrics::clear() {
+    for (int i = 0; i < NUM_METRIC_COUNTERS; i++) {
+        counters[i] = 0;
+    }
+    for (int i = 0; i < NUM_METRIC_MAXIMA; i++) {
+        maxima[i] = 0;
+    }
+    for (int i = 0; i < NUM_METRIC_TIMERS; i++) {
+        timers[i] = {0, 0, 0};
+    }
+}
+
+void GameMetrics::merge(const GameMetrics &other) {
+    for (int i = 0; i < NUM_METRIC_COUNTERS; i++) {
+        counters[i] += other.counters[i];
+    }
+    for (int i = 0; i < NUM_METRIC_MAXIMA; i++) {
+        maxima[i] = (other.maxima[i] > maxima[i]) ? other.maxima[i] : maxima[i];
+    }
+    for (int i = 0; i < NUM_METRIC_TIMERS; i++) {
+        timers[i].count += other.timers[i].count;
+        timers[i].totalNanoseconds += other.timers[i].totalNanoseconds;
+        if (other.timers[i].maxNanoseconds > timers[i].maxNanoseconds) {
+            timers[i].maxNanoseconds = other.timers[i].maxNanoseconds;
+        }
+    }
+}
+
+void Metrics::addTime(MetricTimerId timer, uint64_t nanoseconds) {
+    if (current) {
+        MetricTimer &currTimer = current->timers[timer];
+        currTimer.count++;
+        currTimer.totalNanoseconds += nanoseconds;
+        currTimer.maxNanoseconds = (nanoseconds > currTimer.maxNanoseconds) ? nanoseconds : currTimer.maxNanoseconds;
+    }
+}
+
+void Metrics::addToProcess(const GameMetrics &metrics) {
+    lock_guard<mutex> guard(processLock);
+    processMetrics.merge(metrics);
+}
+
+GameMetrics Metrics::getProcessMetrics() {
+    lock_guard<mutex> guard(processLock);
+    return processMetrics;
+}
+
+void Metrics::writeJson(ostream &out, const GameMetrics &metrics, long long game) {
+    out << "{\"enabled\":" << (isEnabled ? "true" : "false");
+    if (game >= 0) {
+        out << ",\"game\":" << game;
+    }
+    out << ",\"counters\":{";
+    for (int i = 0; i < NUM_METRIC_COUNTERS; i++) {
+        out << (i > 0 ? "," : "") << '"' << getCounterName(MetricCounter(i)) << "\":" << metrics.counters[i];
+    }
+    out << "},\"maxima\":{";
+    for (int i = 0; i < NUM_METRIC_MAXIMA; i++) {
+        out << (i > 0 ? "," : "") << '"' << getMaximumName(MetricMaximum(i)) << "\":" << metrics.maxima[i];
+    }
+    out << "},\"timers\":{";
+    for (int i = 0; i < NUM_METRIC_TIMERS; i++) {
+        const MetricTimer &timer = metrics.timers[i];
+        out << (i > 0 ? "," : "") << '"' << getTimerName(MetricTimerId(i)) << "\":{\"count\":" << timer.count
+            << ",\"total_ns\":" << timer.totalNanoseconds << ",\"max_ns\":" << timer.maxNanoseconds << '}';
+    }
+    out << "}}";
+}
+
+// Counters are Prometheus counters, maxima are gauges and timers are summaries (count and sum) plus a max gauge.
+void Metrics::writePrometheus(ostream &out, const GameMetrics &metrics, const string &labels) {
+    string labelText = labels.empty() ? "" : "{" + labels + "}";
+    out << "# HELP battleship_metrics_enabled 1 if the metrics were compiled in." << endl;
+    out << "# TYPE battleship_metrics_enabled gauge" << endl;
+    out << "battleship_metrics_enabled" << labelText << ' ' << isEnabled << endl;
+    for (int i = 0; i < NUM_METRIC_COUNTERS; i++) {
+        string name = "battleship_" + getCounterName(MetricCounter(i)) + "_total";
+        out << "# TYPE " << name << " counter" << endl;
+        out << name << labelText << ' ' << metrics.counters[i] << endl;
+    }
+    for (int i = 0; i < NUM_METRIC_MAXIMA; i++) {
+        string name = "battleship_" + getMaximumName(MetricMaximum(i));
+        out << "# TYPE " << name << " gauge" << endl;
+        out << name << labelText << ' ' << metrics.maxima[i] << endl;
+    }
+    for (int i = 0; i < NUM_METRIC_TIMERS; i++) {
+        const MetricTimer &timer = metrics.timers[i];
+        string name = "battleship_" + getTimerName(MetricTimerId(i)) + "_seconds";
+        out << "# TYPE " << name << " summary" << endl;
+        out << name << "_count" << labelText << ' ' << timer.count << endl;
+        out << name << "_sum" << labelText << ' ' << timer.totalNanoseconds / 1e9 << endl;
+        out << "# TYPE " << name << "_max gauge" << endl;
+        out << name << "_max" << labelText << ' ' << timer.maxNanoseconds / 1e9 << endl;
+    }
+}
+
+string Metrics::getCounterName(MetricCounter counter) {
+    static const char* names[NUM_METRIC_COUNTERS] = {
+        "probability_passes", "probability_cells", "parity_rebuilds", "cpu_move_calls",
+        "cpu_move_retries", "cpu_move_refills", "cpu_move_fallbacks", "cpu_moves_queued"
+    };
+    return names[counter];
+}
+
+string Metrics::getMaximumName(MetricMaximum maximum) {
+    static const char* names[NUM_METRIC_MAXIMA] = {"cpu_move_max_depth", "cpu_move_max_queued"};
+    return names[maximum];
+}
+
+string Metrics::getTimerName(MetricTimerId timer) {
+    static const char* names[NUM_METRIC_TIMERS] = {"cpu_turn", "shoot", "show_board"};
+    return names[timer];
+}
@@ -0,0 +1,149 @@
+#include "../include/placementOptimizer.hpp"
+#include "../include/battleship.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+using namespace std;
+
+PlacementOptimizer::PlacementOptimizer(int numThreads) {
+    this->numThreads = (numThreads > 0) ? numThreads : 1;
+    setSeed(1);
+    iterations = 2000;
+    restarts = 4;
+    gamesPerVariant = 1;
+    startTemperature = 3;
+    endTemperature = 0.05;
+}
+
+// Deconstructor.
+PlacementOptimizer::~PlacementOptimizer() { }
+
+void PlacementOptimizer::addEngine(DensityEngine engine) {
+    engines.push_back(engine);
+}
+
+// The average shots to win over every engine and symmetry (the same games for every layout).
+double PlacementOptimizer::score(const ShipLayout &fleet) {
+    long long totalShots = 0;
+    long long totalGames = 0;
+    for (DensityEngine engine : engines) {
+        Simulator simulator(numThreads);
+        simulator.setDensityEngine(engine);
+        simulator.setSeed(seed);
+        for (int i = 0; i < LayoutBank::numSymmetries; i++) {
+            simulator.addCorpusLayout(LayoutBank::getLayoutText(LayoutBank::transform(fleet, i)));
+        }
+        SimulationResult result = simulator.run(LayoutBank::numSymmetries * gamesPerVariant);
+        for (unsigned char shots : result.gameShots) {
+            totalShots += shots;
+        }
+        totalGames += result.games;
+    }
+    return (totalGames > 0) ? double(totalShots) / totalGames : 0;
+}
+
+void PlacementOptimizer::run(LayoutBank &bank, int bankSize, ostream* progress) {
+    bestLayouts.clear();
+    for (int restart = 0; restart < restarts; restart++) {
+        ShipLayout current = getRandomLayout();
+        double currScore = score(current);
+        double startScore = currScore;
+        double bestScore = currScore;
+        keepLayout(current, currScore, bankSize);
+
+        for (int i = 0; i < iterations; i++) {
+            // Cools geometrically from the start temperature to the end one.
+            double temperature = startTemperature * pow(endTemperature / startTemperature, double(i) / (iterations - 1));
+            ShipLayout candidate = getNeighbour(current);
+            double candidateScore = score(candidate);
+            double change = candidateScore - currScore;
+            if (change >= 0 || random.nextDouble() < exp(change / temperature)) {
+                current = candidate;
+                currScore = candidateScore;
+                keepLayout(current, currScore, bankSize);
+                bestScore = (currScore > bestScore) ? currScore : bestScore;
+            }
+        }
+
+        if (progress) {
+            *progress << fixed << setprecision(2) << "Restart " << restart + 1 << ": " << startScore
+                      << " -> " << bestScore << " shots" << endl;
+        }
+    }
+
+    for (const auto &entry : bestLayouts) {
+        bank.add(entry.second.fleet, entry.second.score);
+    }
+}
+
+// A fleet from Battleship::placeShips (uniform, like the CPU's fleet in a normal game).
+ShipLayout PlacementOptimizer::getRandomLayout() {
+    Battleship placer;
+    placer.setOutputLevel(QUIET_OUTPUT);
+    placer.setSeed(random.next());
+    placer.startSimulation("");
+    ShipLayout fleet;
+    for (int i = 0; i < Fleet::numShips; i++) {
+        fleet.ships[i] = placer.getBoard(1).getShipMask(i);
+    }
+    return fleet;
+}
+
+// Moves one ship to a free placement: nearby (shifted a little or turned) 3 times in 4, otherwise anywhere.
+ShipLayout PlacementOptimizer::getNeighbour(const ShipLayout &fleet) {
+    ShipLayout neighbour = fleet;
+    int shipId = random.nextBelow(Fleet::numShips);
+    Bitboard occupied;
+    for (int i = 0; i < Fleet::numShips; i++) {
+        occupied |= (i == shipId) ? Bitboard() : fleet.ships[i];
+    }
+
+    int count;
+    const Placement* placements = Fleet::getPlacements(Fleet::getLength(shipId), count);
+    int currStart = fleet.ships[shipId].lowest();
+    bool isLocal = random.nextBelow(4) != 0;
+    int candidates[PlacementTable<Fleet::minLength>::count];
+    int numCandidates = 0;
+    for (int i = 0; i < count; i++) {
+        const Placement &placement = placements[i];
+        int distance = abs(placement.start % 10 - currStart % 10) + abs(placement.start / 10 - currStart / 10);
+        if ((placement.mask & occupied).empty() && placement.mask != fleet.ships[shipId]
+            && (!isLocal || distance <= localDistance)) {
+            candidates[numCandidates++] = i;
+        }
+    }
+
+    if (numCandidates > 0) {
+        neighbour.ships[shipId] = placements[candidates[random.nextBelow(numCandidates)]].mask;
+    }
+    return neighbour;
+}
+
+// Keeps the best bankSize distinct layouts seen so far.
+void PlacementOptimizer::keepLayout(const ShipLayout &fleet, double score, int bankSize) {
+    string key = getCanonicalText(fleet);
+    if (bestLayouts.count(key)) {
+        return;
+    }
+    if (int(bestLayouts.size()) >= bankSize) {
+        auto worst = bestLayouts.begin();
+        for (auto entry = bestLayouts.begin(); entry != bestLayouts.end(); entry++) {
+            worst = (entry->second.score < worst->second.score) ? entry : worst;
+        }
+        if (worst->second.score >= score) {
+            return;
+        }
+        bestLayouts.erase(worst);
+    }
+    bestLayouts[key] = {fleet, score};
+}
+
+// The same text for a layout and all its symmetries.
+string PlacementOptimizer::getCanonicalText(const ShipLayout &fleet) {
+    string canonical = LayoutBank::getLayoutText(fleet);
+    for (int i = 1; i < LayoutBank::numSymmetries; i++) {
+        string text = LayoutBank::getLayoutText(LayoutBank::transform(fleet, i));
+        canonical = (text < canonical) ? text : canonical;
+    }
+    return canonical;
+}
@@ -0,0 +1,13 @@
+#include "../include/randomStrategy.hpp"
+using namespace std;
+
+// Shoots a position that hasn't been shot, each with the same chance.
+Coordinate RandomStrategy::chooseMove() {
+    Bitboard freePos = ~board->getShots() & Bitboard::full();
+    int numFree = freePos.count();
+    if (numFree == 0) {
+        return Coordinate(-1, -1);
+    }
+    int cell = freePos.select(random.nextBelow(numFree));
+    return Coordinate(cell % 10, cell / 10);
+}
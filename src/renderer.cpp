@@ -0,0 +1,156 @@
+#include "../include/renderer.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+using namespace std;
+
+Renderer::Renderer() {
+    frameSize = 0;
+    prevNumPlayers = 0;
+    hasPrevFrame = false;
+    isAnsi = isAnsiTerminal();
+    hasScrollRegion = false;
+}
+
+// Deconstructor gives the whole screen back to the terminal.
+Renderer::~Renderer() {
+    if (hasScrollRegion) {
+        frameSize = 0;
+        append("\x1b" "7\x1b[r\x1b" "8"); // Setting the region moves the cursor, so save and restore it.
+        writeFrame();
+    }
+}
+
+// Only redraw in place when writing straight to a terminal that understands escape codes.
+bool Renderer::isAnsiTerminal() {
+    const char* term = getenv("TERM");
+    return isatty(STDOUT_FILENO) && term && *term && strcmp(term, "dumb") != 0;
+}
+
+// Shows the current contents of the boards.
+void Renderer::render(Board &p1Board, Board &p2Board, int numPlayers) {
+    setCells(p1Board, p2Board, numPlayers);
+    frameSize = 0;
+
+    if (isAnsi && hasPrevFrame && numPlayers == prevNumPlayers) {
+        addChangedCells();
+    } else {
+        if (isAnsi) {
+            append("\x1b[H\x1b[2J"); // Clear the screen, so the boards start at the top.
+        }
+        addFullFrame(numPlayers);
+        if (isAnsi) {
+            // Everything else scrolls below the boards.
+            append("\x1b[");
+            appendNumber(scrollRow);
+            append("r\x1b[");
+            appendNumber(scrollRow);
+            append(";1H");
+            hasScrollRegion = true;
+        }
+    }
+
+    memcpy(prevCells, cells, sizeof(cells));
+    prevNumPlayers = numPlayers;
+    hasPrevFrame = true;
+    writeFrame();
+}
+
+// Sets what each position shows.
+void Renderer::setCells(Board &p1Board, Board &p2Board, int numPlayers) {
+    for (int i = 0; i < 10; i++) {
+        for (int j = 0; j < 10; j++) {
+            // Show P1's ships if it's hit or if it's a single player game.
+            bool isP1Visible = (numPlayers == 1) || p1Board.isPosHit(j, i);
+            cells[0][(i * 10) + j] = isP1Visible ? p1Board.getPiece(j, i) : Board::emptySpace;
+            // Hide the opponents ships if they're not hit.
+            cells[1][(i * 10) + j] = p2Board.isPosHit(j, i) ? p2Board.getPiece(j, i) : Board::emptySpace;
+        }
+    }
+}
+
+// Adds both boards side by side, with their headers.
+void Renderer::addFullFrame(int numPlayers) {
+    switch (numPlayers) {
+        case 2:
+            append("\nP1   A B C D E F G H I J   |  P2   A B C D E F G H I J\n");
+            break;
+        case 1:
+            append("\nYou  A B C D E F G H I J   |  CPU  A B C D E F G H I J\n");
+            break;
+    }
+    append("   ---------------------   |     ---------------------\n");
+
+    for (int i = 0; i < 10; i++) {
+        // The 10th row has no room for the leading space.
+        append((i == 9) ? "" : " ");
+        appendNumber(i + 1);
+        append(" | ");
+        for (int j = 0; j < 10; j++) {
+            append(cells[0][(i * 10) + j]);
+            append(' ');
+        }
+
+        append((i == 9) ? "  |  " : "  |   ");
+        appendNumber(i + 1);
+        append(" | ");
+        for (int j = 0; j < 10; j++) {
+            append(cells[1][(i * 10) + j]);
+            append(' ');
+        }
+        append('\n');
+    }
+}
+
+// Moves the cursor to each position that changed and redraws it, then puts the cursor back.
+void Renderer::addChangedCells() {
+    append("\x1b" "7");
+    for (int board = 0; board < 2; board++) {
+        int firstColumn = (board == 0) ? p1Column : p2Column;
+        for (int i = 0; i < 100; i++) {
+            if (cells[board][i] == prevCells[board][i]) {
+                continue;
+            }
+            append("\x1b[");
+            appendNumber(boardRow + (i / 10));
+            append(';');
+            appendNumber(firstColumn + (2 * (i % 10)));
+            append('H');
+            append(cells[board][i]);
+        }
+    }
+    append("\x1b" "8");
+}
+
+void Renderer::append(const char* text) {
+    while (*text) {
+        frame[frameSize++] = *text++;
+    }
+}
+
+// Positive numbers only (rows, columns and row labels).
+void Renderer::appendNumber(int number) {
+    char digits[12];
+    int numDigits = 0;
+    do {
+        digits[numDigits++] = char('0' + (number % 10));
+        number /= 10;
+    } while (number > 0);
+    while (numDigits > 0) {
+        append(digits[--numDigits]);
+    }
+}
+
+// Writes the frame in one go (after any messages still buffered by cout).
+void Renderer::writeFrame() {
+    cout.flush();
+    int written = 0;
+    while (written < frameSize) {
+        ssize_t result = write(STDOUT_FILENO, frame + written, frameSize - written);
+        if (result <= 0) {
+            break;
+        }
+        written += int(result);
+    }
+}
@@ -0,0 +1,139 @@
+#include "../include/replay.hpp"
+#include "../include/layoutValidator.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+using namespace std;
+
+Replay::Replay() {
+    seed = 0;
+    engine = APPROXIMATE_DENSITY;
+    endgameThreshold = 0;
+}
+
+// Deconstructor.
+Replay::~Replay() { }
+
+void Replay::setUpGame(BattleshipCPU &game, uint64_t seed, DensityEngine engine, const string &layout,
+                       int endgameThreshold) {
+    game.setOutputLevel(QUIET_OUTPUT);
+    game.setDensityEngine(engine);
+    game.setEndgameThreshold(endgameThreshold); // The game may be reused, so it's always set.
+    game.setSeed(seed);
+    // The sampler has to stop on its sample count, not the clock.
+    game.getSampler().setNumThreads(1);
+    game.getSampler().setLatencyBudget(0);
+    game.startSimulation(layout);
+}
+
+Replay Replay::record(uint64_t seed, DensityEngine engine, const string &layout, int endgameThreshold) {
+    BattleshipCPU game;
+    setUpGame(game, seed, engine, layout, endgameThreshold);
+
+    Replay replay;
+    replay.seed = seed;
+    replay.engine = engine;
+    replay.endgameThreshold = endgameThreshold;
+    replay.layout = game.getBoardLayout(1);
+    while (!game.isP2Win() && replay.moves.size() < 100) {
+        game.cpuShoot();
+        replay.moves.push_back(game.getLastMove());
+    }
+    return replay;
+}
+
+int Replay::verify() const {
+    BattleshipCPU game;
+    setUpGame(game, seed, engine, layout, endgameThreshold);
+
+    // A game can't go on past 100 shots (the next one would repeat a position).
+    for (int i = 0; i < int(moves.size()); i++) {
+        if (game.isP2Win() || game.getBoard(1).getNumShots() == 100) {
+            return i;
+        }
+        game.cpuShoot();
+        if (game.getLastMove() != moves[i]) {
+            return i;
+        }
+    }
+    // The game has to end on the last move as well.
+    return game.isP2Win() ? -1 : int(moves.size());
+}
+
+void Replay::save(string fileName) const {
+    ofstream replayFile(fileName);
+    if (!replayFile.is_open()) {
+        throw runtime_error("The replay file '" + fileName + "' cannot be written.");
+    }
+
+    replayFile << "seed " << seed << endl;
+    replayFile << "engine " << BattleshipCPU::getEngineName(engine) << endl;
+    replayFile << "endgame " << endgameThreshold << endl;
+    replayFile << "layout " << layout << endl;
+    replayFile << "moves";
+    for (int move : moves) {
+        replayFile << ' ' << move;
+    }
+    replayFile << endl;
+}
+
+Replay Replay::load(string fileName) {
+    ifstream replayFile(fileName);
+    if (!replayFile.is_open()) {
+        throw runtime_error("The replay file '" + fileName + "' cannot be found.");
+    }
+
+    Replay replay;
+    bool hasSeed = false;
+    string line;
+    while (getline(replayFile, line)) {
+        istringstream fields(line);
+        string key;
+        fields >> key;
+
+        if (key == "seed") {
+            hasSeed = bool(fields >> replay.seed);
+        } else if (key == "engine") {
+            string name;
+            fields >> name;
+            if (!BattleshipCPU::getEngine(name, replay.engine)) {
+                throw runtime_error("Unknown density engine '" + name + "' in " + fileName);
+            }
+        } else if (key == "endgame") {
+            if (!(fields >> replay.endgameThreshold) || replay.endgameThreshold < 0) {
+                throw runtime_error("Invalid endgame threshold in " + fileName);
+            }
+        } else if (key == "layout") {
+            fields >> replay.layout;
+        } else if (key == "moves") {
+            int move;
+            while (fields >> move) {
+                if (move < 0 || move > 99) {
+                    throw runtime_error("Invalid move in " + fileName);
+                }
+                replay.moves.push_back(move);
+            }
+        }
+    }
+
+    if (!hasSeed || replay.layout.length() != 100) {
+        throw runtime_error("The replay file '" + fileName + "' is missing its seed or layout.");
+    }
+
+    // The layout is played as it is, so it has to be a whole fleet.
+    Bitboard ships[Fleet::numShips];
+    for (int cell = 0; cell < 100; cell++) {
+        int shipId = Board::getShipId(replay.layout[cell]);
+        if (shipId >= 0) {
+            ships[shipId] |= Bitboard::cell(cell);
+        } else if (replay.layout[cell] != Board::emptySpace) {
+            throw runtime_error("Invalid piece '" + string(1, replay.layout[cell]) + "' in the layout of " + fileName);
+        }
+    }
+    int shipId;
+    LayoutError error = LayoutValidator::validate(ships, shipId);
+    if (error != LAYOUT_OK) {
+        throw runtime_error("Invalid layout in " + fileName + ": " + LayoutValidator::getMessage(error));
+    }
+    return replay;
+}
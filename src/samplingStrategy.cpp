@@ -0,0 +1,21 @@
+#include "../include/samplingStrategy.hpp"
+#include "../include/metrics.hpp"
+using namespace std;
+
+// Shoots the position most often covered by the sampled fleets.
+// The estimates are scaled to integers so they compare the same way as the other densities.
+Coordinate SamplingStrategy::chooseMove() {
+    Coordinate endgameMove(-1, -1);
+    if (chooseEndgameMove(endgameMove)) {
+        return endgameMove;
+    }
+    double occupancy[100];
+    int density[100];
+    sampler.estimate(board->getTargetView(), occupancy);
+    METRIC_ADD(PROBABILITY_PASSES, 1);
+    METRIC_ADD(PROBABILITY_CELLS, 100 - board->getShots().count());
+    for (int i = 0; i < 100; i++) {
+        density[i] = int(occupancy[i] * 100000);
+    }
+    return chooseDensityMove(density);
+}
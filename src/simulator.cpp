@@ -0,0 +1,189 @@
+#include "../include/simulator.hpp"
+#include "../include/workStealingPool.hpp"
+#include "../include/replay.hpp"
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+using namespace std;
+
+// Per thread tallies, padded so threads don't share cache lines.
+struct alignas(64) WorkerStats {
+    long long games = 0;
+    double seconds = 0;
+    vector<long long> shotHistogram = vector<long long>(101, 0);
+    long long worstGame = -1;
+    int worstShots = 0;
+    LatencyHistogram turnLatency;
+    ObjectPool<BattleshipCPU> gamePool; // Reused, so a game is set up without allocating.
+};
+
+Simulator::Simulator(int numThreads) {
+    this->numThreads = (numThreads > 0) ? numThreads : 1;
+    densityEngine = APPROXIMATE_DENSITY;
+    endgameThreshold = 0;
+    seed = 1;
+    archive = nullptr;
+    metricsLog = nullptr;
+    isMixed = false;
+}
+
+// Deconstructor.
+Simulator::~Simulator() { }
+
+// Loads a board file (from the boards folder) into the corpus.
+// Throws runtime_error if the file is missing or invalid, like startGame.
+void Simulator::addCorpusBoard(string fileName) {
+    BattleshipCPU loader;
+    loader.setOutputLevel(QUIET_OUTPUT);
+    loader.setBoardFile(1, fileName);
+    loader.startGame(1, true, false);
+    corpus.push_back(loader.getBoardLayout(1));
+}
+
+// Each game gets its own seed, so any game of a run can be played again on its own.
+uint64_t Simulator::getGameSeed(long long game) {
+    return seed ^ (uint64_t(game) * 0x9E3779B97F4A7C15ULL);
+}
+
+const string& Simulator::getGameLayout(long long game) {
+    static const string randomLayout;
+    if (corpus.empty() || (isMixed && game % 2 == 0)) {
+        return randomLayout;
+    }
+    return corpus[(isMixed ? game / 2 : game) % corpus.size()];
+}
+
+// Plays the given number of games across the worker threads.
+// A run can carry on from an earlier one, since each game only depends on its index.
+SimulationResult Simulator::run(long long numGames, long long firstGame) {
+    WorkStealingPool pool(numThreads);
+    vector<WorkerStats> stats(numThreads);
+    SimulationResult result;
+    result.gameShots.assign(numGames, 0);
+
+    // Split the games into small tasks, so idle threads have something to steal.
+    long long endGame = firstGame + numGames;
+    for (long long first = firstGame; first < endGame; first += gamesPerTask) {
+        long long last = (first + gamesPerTask < endGame) ? first + gamesPerTask : endGame;
+        pool.submit([this, &stats, &result, firstGame, first, last](int workerId) {
+            WorkerStats &currStats = stats[workerId];
+            vector<unsigned char> records; // Encoded games, written once the task is done.
+            ostringstream metricsLines;
+            auto start = chrono::steady_clock::now();
+            for (long long i = first; i < last; i++) {
+                BattleshipCPU* game = currStats.gamePool.acquire();
+                int shots = playGame(i, *game, records, currStats.turnLatency);
+                if (metricsLog) {
+                    Metrics::writeJson(metricsLines, game->getMetrics(), i);
+                    metricsLines << '\n';
+                }
+                currStats.gamePool.release(game);
+                result.gameShots[i - firstGame] = shots; // Each game is only written by its task.
+                currStats.shotHistogram[shots]++;
+                currStats.games++;
+                // Tasks can finish in any order, so ties go to the earliest game.
+                if (shots > currStats.worstShots || (shots == currStats.worstShots && i < currStats.worstGame)) {
+                    currStats.worstShots = shots;
+                    currStats.worstGame = i;
+                }
+            }
+            currStats.seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            if (archive && !records.empty()) {
+                archive->writeEncoded(records.data(), records.size());
+            }
+            if (metricsLog) {
+                lock_guard<mutex> guard(metricsLock);
+                *metricsLog << metricsLines.str();
+            }
+        });
+    }
+
+    auto start = chrono::steady_clock::now();
+    pool.run();
+
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    result.shotHistogram.assign(101, 0);
+    for (int i = 0; i < numThreads; i++) {
+        result.games += stats[i].games;
+        result.threadGames.push_back(stats[i].games);
+        result.threadSeconds.push_back(stats[i].seconds);
+        result.threadSteals.push_back(pool.getSteals(i));
+        bool isWorse = stats[i].worstShots > result.worstShots;
+        bool isEarlierTie = stats[i].worstShots == result.worstShots && stats[i].worstGame < result.worstGame;
+        if (stats[i].worstGame >= 0 && (isWorse || isEarlierTie || result.worstGame < 0)) {
+            result.worstShots = stats[i].worstShots;
+            result.worstGame = stats[i].worstGame;
+        }
+        for (int j = 0; j <= 100; j++) {
+            result.shotHistogram[j] += stats[i].shotHistogram[j];
+        }
+        result.turnLatency.merge(stats[i].turnLatency);
+    }
+    return result;
+}
+
+// Plays one game and returns the number of shots the CPU took to win.
+// It's set up like a replay, so Replay::record gives the same game.
+// The encoded game is added to records if there's an archive, and each turn's time to turnLatency.
+int Simulator::playGame(long long gameIndex, BattleshipCPU &game, vector<unsigned char> &records,
+                        LatencyHistogram &turnLatency) {
+    Replay::setUpGame(game, getGameSeed(gameIndex), densityEngine, getGameLayout(gameIndex), endgameThreshold);
+
+    int shots = 0;
+    while (!game.isP2Win() && shots < 100) {
+        auto start = chrono::steady_clock::now();
+        game.cpuShoot();
+        turnLatency.add(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+        shots++;
+    }
+
+    if (archive) {
+        size_t size = records.size();
+        records.resize(size + GameArchive::maxRecordSize);
+        records.resize(size + GameArchive::encode(GameArchive::makeRecord(game), records.data() + size));
+    }
+    return shots;
+}
+
+// Prints the throughput, the shots to win histogram and the per thread throughput.
+void Simulator::printReport(const SimulationResult &result, ostream &out) {
+    out << fixed << setprecision(2);
+    out << "Games: " << result.games << " in " << result.seconds << "s ("
+        << (result.seconds > 0 ? result.games / result.seconds : 0) << " games/sec)" << endl;
+
+    // Shots to win.
+    long long totalShots = 0;
+    long long maxCount = 0;
+    for (int i = 0; i <= 100; i++) {
+        totalShots += i * result.shotHistogram[i];
+        maxCount = (result.shotHistogram[i] > maxCount) ? result.shotHistogram[i] : maxCount;
+    }
+    if (result.games > 0) {
+        double threadSeconds = 0;
+        for (double seconds : result.threadSeconds) {
+            threadSeconds += seconds;
+        }
+        out << "Average shots to win: " << double(totalShots) / result.games << endl;
+        out << "Average time per turn: " << (threadSeconds * 1e6) / totalShots << " us" << endl;
+        const LatencyHistogram &latency = result.turnLatency;
+        out << "Turn latency: p50 " << latency.getPercentile(50) / 1e3 << " us, p99 "
+            << latency.getPercentile(99) / 1e3 << " us, max " << latency.getMax() / 1e3 << " us" << endl;
+        out << "Most shots: " << result.worstShots << " (game " << result.worstGame << ")" << endl;
+    }
+    out << "Shots  Games" << endl;
+    for (int i = 0; i <= 100; i++) {
+        if (result.shotHistogram[i] == 0) {
+            continue;
+        }
+        int barLength = int((40 * result.shotHistogram[i]) / maxCount);
+        out << setw(5) << i << "  " << setw(10) << result.shotHistogram[i] << ' ' << string(barLength, '#') << endl;
+    }
+
+    // Per thread throughput.
+    out << "Thread  Games       Games/sec   Steals" << endl;
+    for (int i = 0; i < int(result.threadGames.size()); i++) {
+        double rate = (result.threadSeconds[i] > 0) ? result.threadGames[i] / result.threadSeconds[i] : 0;
+        out << setw(6) << i << "  " << setw(10) << result.threadGames[i] << "  " << setw(10) << rate
+            << "  " << setw(6) << result.threadSteals[i] << endl;
+    }
+}
@@ -0,0 +1,206 @@
+#include "../include/tournament.hpp"
+#include <cmath>
+#include <iomanip>
+using namespace std;
+
+Tournament::Tournament(int numThreads) {
+    this->numThreads = (numThreads > 0) ? numThreads : 1;
+    seed = 1;
+    roundGames = 200;
+    maxGames = 20000;
+    alpha = 0.05;
+    margin = 0.25;
+    criticalValue = 0;
+}
+
+// Deconstructor.
+Tournament::~Tournament() { }
+
+void Tournament::addEngine(DensityEngine engine, int endgameThreshold) {
+    TournamentEntry entry;
+    entry.engine = engine;
+    entry.endgameThreshold = endgameThreshold;
+    entry.isActive = true;
+    entries.push_back(entry);
+}
+
+// Plays rounds until every pair is settled (or an entry reaches the game limit).
+void Tournament::run(ostream* progress) {
+    comparisons.clear();
+    for (int i = 0; i < int(entries.size()); i++) {
+        for (int j = i + 1; j < int(entries.size()); j++) {
+            comparisons.push_back({i, j, 0, 0, 0, VERDICT_UNDECIDED});
+        }
+    }
+    long long maxRounds = (maxGames + roundGames - 1) / roundGames;
+    long long numLooks = (comparisons.empty() ? 1 : comparisons.size()) * (maxRounds > 0 ? maxRounds : 1);
+    criticalValue = getCriticalValue(alpha / numLooks);
+    updateActive();
+
+    for (int round = 1; ; round++) {
+        bool isPlaying = false;
+        for (TournamentEntry &entry : entries) {
+            if (entry.isActive) {
+                playRound(entry);
+                isPlaying = true;
+            }
+        }
+        if (!isPlaying) {
+            break;
+        }
+        for (TournamentComparison &comparison : comparisons) {
+            compare(comparison);
+        }
+        updateActive();
+
+        if (progress) {
+            int numSettled = 0;
+            for (const TournamentComparison &comparison : comparisons) {
+                numSettled += comparison.verdict != VERDICT_UNDECIDED;
+            }
+            *progress << "Round " << round << ": " << numSettled << " of " << comparisons.size()
+                      << " comparisons settled" << endl;
+        }
+    }
+}
+
+// Plays the entry's next round of games.
+void Tournament::playRound(TournamentEntry &entry) {
+    Simulator simulator(numThreads);
+    simulator.setDensityEngine(entry.engine);
+    simulator.setEndgameThreshold(entry.endgameThreshold);
+    simulator.setSeed(seed);
+    simulator.setMixedFleets(true);
+    for (const string &layout : corpus) {
+        simulator.addCorpusLayout(layout);
+    }
+
+    long long firstGame = entry.gameShots.size();
+    long long numGames = (firstGame + roundGames < maxGames) ? roundGames : maxGames - firstGame;
+    SimulationResult result = simulator.run(numGames, firstGame);
+    entry.gameShots.insert(entry.gameShots.end(), result.gameShots.begin(), result.gameShots.end());
+    entry.turnLatency.merge(result.turnLatency);
+}
+
+// Compares a pair on the games both have played.
+void Tournament::compare(TournamentComparison &comparison) {
+    const vector<unsigned char> &first = entries[comparison.first].gameShots;
+    const vector<unsigned char> &second = entries[comparison.second].gameShots;
+    long long games = (first.size() < second.size()) ? first.size() : second.size();
+    if (games < 2 || comparison.verdict != VERDICT_UNDECIDED) {
+        return;
+    }
+
+    double sum = 0;
+    double sumSquares = 0;
+    for (long long i = 0; i < games; i++) {
+        double difference = double(first[i]) - double(second[i]);
+        sum += difference;
+        sumSquares += difference * difference;
+    }
+    double mean = sum / games;
+    double variance = (sumSquares - (sum * mean)) / (games - 1);
+    comparison.games = games;
+    comparison.meanDifference = mean;
+    comparison.halfWidth = criticalValue * sqrt((variance > 0 ? variance : 0) / games);
+
+    if (mean - comparison.halfWidth > 0) {
+        comparison.verdict = VERDICT_SECOND_BETTER;
+    } else if (mean + comparison.halfWidth < 0) {
+        comparison.verdict = VERDICT_FIRST_BETTER;
+    } else if (fabs(mean) + comparison.halfWidth < margin) {
+        comparison.verdict = VERDICT_EQUIVALENT;
+    }
+}
+
+// An entry keeps playing while one of its comparisons is undecided and it's under the game limit.
+void Tournament::updateActive() {
+    for (TournamentEntry &entry : entries) {
+        entry.isActive = false;
+    }
+    for (const TournamentComparison &comparison : comparisons) {
+        if (comparison.verdict == VERDICT_UNDECIDED) {
+            entries[comparison.first].isActive = true;
+            entries[comparison.second].isActive = true;
+        }
+    }
+    for (TournamentEntry &entry : entries) {
+        entry.isActive = entry.isActive && (long long)entry.gameShots.size() < maxGames;
+    }
+}
+
+// Prints each entry's shots to win (with a 95% interval) and decision time, then each comparison.
+void Tournament::printReport(ostream &out) {
+    out << fixed << setprecision(2);
+    out << "Engine          Games   Shots to win (95% CI)   Mean decision   p99 decision" << endl;
+    for (const TournamentEntry &entry : entries) {
+        double mean;
+        double halfWidth;
+        getMeanInterval(entry.gameShots, mean, halfWidth);
+        out << left << setw(14) << getEntryName(entry) << right
+            << setw(7) << entry.gameShots.size() << "   " << setw(6) << mean << " +/- " << setw(5) << halfWidth
+            << "       " << setw(9) << entry.turnLatency.getMean() / 1e3 << " us"
+            << "   " << setw(9) << entry.turnLatency.getPercentile(99) / 1e3 << " us" << endl;
+    }
+
+    out << "Comparisons (alpha " << alpha << " overall, margin " << margin << " shots):" << endl;
+    for (const TournamentComparison &comparison : comparisons) {
+        out << "  " << getEntryName(entries[comparison.first]) << " - "
+            << getEntryName(entries[comparison.second]) << ": "
+            << showpos << comparison.meanDifference << noshowpos << " +/- " << comparison.halfWidth
+            << " shots over " << comparison.games << " games, " << getVerdictText(comparison, entries) << endl;
+    }
+}
+
+string Tournament::getEntryName(const TournamentEntry &entry) {
+    string name = BattleshipCPU::getEngineName(entry.engine);
+    return (entry.endgameThreshold > 0) ? name + ":" + to_string(entry.endgameThreshold) : name;
+}
+
+string Tournament::getVerdictText(const TournamentComparison &comparison, const vector<TournamentEntry> &entries) {
+    switch (comparison.verdict) {
+        case VERDICT_FIRST_BETTER:
+            return getEntryName(entries[comparison.first]) + " is better";
+        case VERDICT_SECOND_BETTER:
+            return getEntryName(entries[comparison.second]) + " is better";
+        case VERDICT_EQUIVALENT:
+            return "equivalent";
+        default:
+            return "undecided (game limit reached)";
+    }
+}
+
+// The mean and the half width of its 95% interval (normal approximation).
+void Tournament::getMeanInterval(const vector<unsigned char> &shots, double &mean, double &halfWidth) {
+    mean = 0;
+    halfWidth = 0;
+    if (shots.empty()) {
+        return;
+    }
+    double sum = 0;
+    double sumSquares = 0;
+    for (unsigned char currShots : shots) {
+        sum += currShots;
+        sumSquares += double(currShots) * currShots;
+    }
+    mean = sum / shots.size();
+    if (shots.size() > 1) {
+        double variance = (sumSquares - (sum * mean)) / (shots.size() - 1);
+        halfWidth = 1.959964 * sqrt((variance > 0 ? variance : 0) / shots.size());
+    }
+}
+
+// Finds z where P(|Z| > z) = alpha by bisection (the tail probability falls as z grows).
+double Tournament::getCriticalValue(double alpha) {
+    double low = 0;
+    double high = 40;
+    for (int i = 0; i < 100; i++) {
+        double middle = (low + high) / 2;
+        if (erfc(middle / sqrt(2.0)) > alpha) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return (low + high) / 2;
+}
@@ -0,0 +1,81 @@
+#include "../include/workStealingPool.hpp"
+#include <thread>
+using namespace std;
+
+WorkStealingPool::WorkStealingPool(int numThreads) {
+    this->numThreads = (numThreads > 0) ? numThreads : 1;
+    nextQueue = 0;
+    pendingTasks = 0;
+    for (int i = 0; i < this->numThreads; i++) {
+        queues.push_back(unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+}
+
+// Deconstructor.
+WorkStealingPool::~WorkStealingPool() { }
+
+// Adds a task to the next worker's queue.
+void WorkStealingPool::submit(function<void(int)> task) {
+    WorkerQueue &currQueue = *queues[nextQueue];
+    nextQueue = (nextQueue + 1) % numThreads;
+
+    lock_guard<mutex> guard(currQueue.lock);
+    currQueue.tasks.push_back(move(task));
+    pendingTasks++;
+}
+
+// Starts the workers and waits for them to empty every queue.
+void WorkStealingPool::run() {
+    vector<thread> workers;
+    // The calling thread acts as worker 0.
+    for (int i = 1; i < numThreads; i++) {
+        workers.push_back(thread(&WorkStealingPool::workerLoop, this, i));
+    }
+    workerLoop(0);
+
+    for (thread &worker : workers) {
+        worker.join();
+    }
+}
+
+// Runs tasks until there are none left anywhere.
+void WorkStealingPool::workerLoop(int workerId) {
+    function<void(int)> task;
+    while (pendingTasks > 0) {
+        if (popTask(workerId, task) || stealTask(workerId, task)) {
+            task(workerId);
+            pendingTasks--;
+        } else {
+            // Other workers hold the remaining tasks.
+            this_thread::yield();
+        }
+    }
+}
+
+// Takes a task from the front of the worker's own queue.
+bool WorkStealingPool::popTask(int workerId, function<void(int)> &task) {
+    WorkerQueue &ownQueue = *queues[workerId];
+    lock_guard<mutex> guard(ownQueue.lock);
+    if (ownQueue.tasks.empty()) {
+        return false;
+    }
+    task = move(ownQueue.tasks.front());
+    ownQueue.tasks.pop_front();
+    return true;
+}
+
+// Takes a task from the back of another worker's queue.
+bool WorkStealingPool::stealTask(int workerId, function<void(int)> &task) {
+    for (int i = 1; i < numThreads; i++) {
+        WorkerQueue &victim = *queues[(workerId + i) % numThreads];
+        lock_guard<mutex> guard(victim.lock);
+        if (victim.tasks.empty()) {
+            continue;
+        }
+        task = move(victim.tasks.back());
+        victim.tasks.pop_back();
+        queues[workerId]->steals++;
+        return true;
+    }
+    return false;
+}
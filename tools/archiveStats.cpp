@@ -0,0 +1,80 @@
+#include "../include/gameArchive.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+using namespace std;
+
+// Shots to win and per position hit rates, read straight from a game archive.
+// Usage: archiveStats archiveFile
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << "Usage: archiveStats archiveFile" << endl;
+        return 1;
+    }
+
+    ArchiveReader reader;
+    try {
+        reader.open(argv[1]);
+    } catch (runtime_error &e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+
+    long long games = 0;
+    long long wins = 0;
+    long long winShots = 0;
+    long long shotHistogram[101] = {0};
+    long long cellShots[100] = {0};
+    long long cellHits[100] = {0};
+
+    auto start = chrono::steady_clock::now();
+    GameView game;
+    while (reader.next(game)) {
+        games++;
+        for (int i = 0; i < game.getNumBoards(); i++) {
+            for (int j = 0; j < game.getNumShots(i); j++) {
+                int pos = game.getShotPos(i, j);
+                cellShots[pos]++;
+                cellHits[pos] += game.isShotHit(i, j);
+            }
+        }
+
+        int loserBoard = game.getLoserBoard();
+        if (loserBoard >= 0 && loserBoard < game.getNumBoards()) {
+            int shots = game.getNumShots(loserBoard);
+            wins++;
+            winShots += shots;
+            shotHistogram[shots]++;
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << fixed << setprecision(2);
+    cout << "Games: " << games << " (" << reader.getSize() / 1e6 << " MB read in " << seconds << "s)" << endl;
+    if (reader.isDamaged()) {
+        cout << "Warning: the archive ends with a damaged record." << endl;
+    }
+    if (wins > 0) {
+        cout << "Average shots to win: " << double(winShots) / wins << endl;
+    }
+    cout << "Shots  Games" << endl;
+    for (int i = 0; i <= 100; i++) {
+        if (shotHistogram[i] > 0) {
+            cout << setw(5) << i << "  " << setw(10) << shotHistogram[i] << endl;
+        }
+    }
+
+    // Hit rate of each position, as a percentage of the shots at it.
+    cout << "Hit rate (%)" << endl;
+    cout << "      A     B     C     D     E     F     G     H     I     J" << endl;
+    for (int i = 0; i < 10; i++) {
+        cout << setw(2) << i + 1;
+        for (int j = 0; j < 10; j++) {
+            int pos = (i * 10) + j;
+            double rate = (cellShots[pos] > 0) ? (100.0 * cellHits[pos]) / cellShots[pos] : 0;
+            cout << setw(6) << setprecision(1) << rate;
+        }
+        cout << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,181 @@
+#include "../include/fastRandom.hpp"
+#include "../include/latencyHistogram.hpp"
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+using namespace std;
+
+// Plays many games against a running server at once and measures it.
+// Usage: loadgen [-p port] [-u socketPath] [-c connections] [-g gamesPerConnection] [-e engine] [-s seed]
+// Each connection is one session on its own thread: it starts a seeded game against the CPU and
+// shoots every position in a random order until someone wins, timing every request.
+
+struct ClientStats {
+    long long games = 0;
+    long long shots = 0;
+    long long errors = 0;
+    LatencyHistogram latency;
+};
+
+// A blocking connection that sends a request line and waits for the response line.
+class LineClient {
+    public:
+        LineClient() { fd = -1; }
+        ~LineClient() { if (fd >= 0) close(fd); }
+
+        bool connectTcp(int port) {
+            fd = socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in address = {};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            address.sin_port = htons(port);
+            int noDelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+            return fd >= 0 && connect(fd, (sockaddr*)&address, sizeof(address)) == 0;
+        }
+
+        bool connectUnix(const string &path) {
+            fd = socket(AF_UNIX, SOCK_STREAM, 0);
+            sockaddr_un address = {};
+            address.sun_family = AF_UNIX;
+            strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+            return fd >= 0 && connect(fd, (sockaddr*)&address, sizeof(address)) == 0;
+        }
+
+        bool request(const string &line, string &response) {
+            string message = line + '\n';
+            if (send(fd, message.data(), message.length(), MSG_NOSIGNAL) != (ssize_t)message.length()) {
+                return false;
+            }
+            size_t lineEnd;
+            while ((lineEnd = buffer.find('\n')) == string::npos) {
+                char chunk[4096];
+                ssize_t numRead = read(fd, chunk, sizeof(chunk));
+                if (numRead <= 0) {
+                    return false;
+                }
+                buffer.append(chunk, numRead);
+            }
+            response = buffer.substr(0, lineEnd);
+            buffer.erase(0, lineEnd + 1);
+            return true;
+        }
+    private:
+        int fd;
+        string buffer; // Received, but not returned yet.
+};
+
+static void runClient(int port, const string &socketPath, int numGames, const string &engine, uint64_t seed,
+                      ClientStats &stats) {
+    LineClient client;
+    bool isConnected = socketPath.empty() ? client.connectTcp(port) : client.connectUnix(socketPath);
+    if (!isConnected) {
+        stats.errors++;
+        return;
+    }
+
+    FastRandom random(seed);
+    string response;
+    for (int game = 0; game < numGames; game++) {
+        if (!client.request("NEW 1 " + to_string(seed + game) + " " + engine, response) || response != "OK") {
+            stats.errors++;
+            return;
+        }
+
+        // Every position once, in a random order.
+        int cells[100];
+        for (int i = 0; i < 100; i++) {
+            cells[i] = i;
+        }
+        for (int i = 99; i > 0; i--) {
+            swap(cells[i], cells[random.nextBelow(i + 1)]);
+        }
+
+        for (int i = 0; i < 100; i++) {
+            string shot = "SHOOT " + string(1, char('A' + (cells[i] % 10))) + to_string((cells[i] / 10) + 1);
+            auto start = chrono::steady_clock::now();
+            if (!client.request(shot, response)) {
+                stats.errors++;
+                return;
+            }
+            stats.latency.add(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+            stats.shots++;
+            if (response.compare(0, 2, "OK") != 0) {
+                stats.errors++;
+            }
+            if (response.find(" WIN ") != string::npos) {
+                break;
+            }
+        }
+        stats.games++;
+    }
+    client.request("QUIT", response);
+}
+
+int main(int argc, char* argv[]) {
+    int port = 7070;
+    string socketPath;
+    int numConnections = 16;
+    int numGames = 20;
+    string engine = "approximate";
+    uint64_t seed = 1;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "-p" && i + 1 < argc) {
+            port = stoi(argv[++i]);
+        } else if (arg == "-u" && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (arg == "-c" && i + 1 < argc) {
+            numConnections = stoi(argv[++i]);
+        } else if (arg == "-g" && i + 1 < argc) {
+            numGames = stoi(argv[++i]);
+        } else if (arg == "-e" && i + 1 < argc) {
+            engine = argv[++i];
+        } else if (arg == "-s" && i + 1 < argc) {
+            seed = stoull(argv[++i]);
+        } else {
+            cout << "Usage: loadgen [-p port] [-u socketPath] [-c connections] [-g gamesPerConnection] [-e engine] [-s seed]" << endl;
+            return 1;
+        }
+    }
+
+    vector<ClientStats> stats(numConnections);
+    vector<thread> clients;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < numConnections; i++) {
+        uint64_t clientSeed = seed + (uint64_t(i) * 1000003);
+        clients.push_back(thread(runClient, port, socketPath, numGames, engine, clientSeed, ref(stats[i])));
+    }
+    for (thread &client : clients) {
+        client.join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    ClientStats total;
+    for (const ClientStats &currStats : stats) {
+        total.games += currStats.games;
+        total.shots += currStats.shots;
+        total.errors += currStats.errors;
+        total.latency.merge(currStats.latency);
+    }
+
+    cout << "Sessions: " << numConnections << ", games: " << total.games << ", shots: " << total.shots
+         << ", errors: " << total.errors << endl;
+    cout << "Time: " << seconds << "s (" << (seconds > 0 ? total.shots / seconds : 0) << " shots/sec, "
+         << (seconds > 0 ? total.games / seconds : 0) << " games/sec)" << endl;
+    if (total.latency.getCount() > 0) {
+        cout << "Shot latency: p50 " << total.latency.getPercentile(50) / 1e3 << " us, p99 "
+             << total.latency.getPercentile(99) / 1e3 << " us, p99.9 " << total.latency.getPercentile(99.9) / 1e3
+             << " us, max " << total.latency.getMax() / 1e3 << " us" << endl;
+    }
+    return (total.errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+#include "../include/placementOptimizer.hpp"
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+using namespace std;
+
+// Searches for fleet layouts the CPU takes many shots to find, and saves the best as a layout bank.
+// Usage: optimize [-e engine]... [-t numThreads] [-s seed] [-i iterations] [-r restarts] [-g gamesPerVariant] [-k bankSize] [-o bankFile]
+// Without -e the layouts are scored against the approximate and exact engines.
+// The game draws the CPU's fleet from ../layouts.bank (the default bankFile) when it exists.
+int main(int argc, char* argv[]) {
+    int numThreads = thread::hardware_concurrency();
+    vector<DensityEngine> engines;
+    uint64_t seed = random_device()();
+    int iterations = 2000;
+    int restarts = 4;
+    int gamesPerVariant = 1;
+    int bankSize = 32;
+    string bankFile = "../layouts.bank";
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        DensityEngine engine;
+        if (arg == "-e" && i + 1 < argc && BattleshipCPU::getEngine(argv[i + 1], engine)) {
+            engines.push_back(engine);
+            i++;
+        } else if (arg == "-t" && i + 1 < argc) {
+            numThreads = stoi(argv[++i]);
+        } else if (arg == "-s" && i + 1 < argc) {
+            seed = stoull(argv[++i]);
+        } else if (arg == "-i" && i + 1 < argc) {
+            iterations = stoi(argv[++i]);
+        } else if (arg == "-r" && i + 1 < argc) {
+            restarts = stoi(argv[++i]);
+        } else if (arg == "-g" && i + 1 < argc) {
+            gamesPerVariant = stoi(argv[++i]);
+        } else if (arg == "-k" && i + 1 < argc) {
+            bankSize = stoi(argv[++i]);
+        } else if (arg == "-o" && i + 1 < argc) {
+            bankFile = argv[++i];
+        } else {
+            cout << "Usage: optimize [-e engine]... [-t numThreads] [-s seed] [-i iterations] [-r restarts] [-g gamesPerVariant] [-k bankSize] [-o bankFile]" << endl;
+            return 1;
+        }
+    }
+    if (engines.empty()) {
+        engines = {APPROXIMATE_DENSITY, EXACT_DENSITY};
+    }
+
+    PlacementOptimizer optimizer(numThreads);
+    optimizer.setSeed(seed);
+    optimizer.setIterations(iterations);
+    optimizer.setRestarts(restarts);
+    optimizer.setGamesPerVariant(gamesPerVariant);
+    for (DensityEngine engine : engines) {
+        optimizer.addEngine(engine);
+    }
+
+    cout << "Seed: " << seed << endl;
+    LayoutBank bank;
+    optimizer.run(bank, bankSize, &cout);
+    try {
+        bank.save(bankFile);
+    } catch (runtime_error &e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Saved " << bank.size() << " layouts to " << bankFile;
+    if (!bank.empty()) {
+        cout << " (best " << bank.getLayout(0).score << " shots, worst " << bank.getLayout(bank.size() - 1).score << ")";
+    }
+    cout << endl;
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include "../include/replay.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+using namespace std;
+
+// Plays a game back, showing the boards and messages after every shot.
+static void show(const Replay &replay) {
+    BattleshipCPU game;
+    Replay::setUpGame(game, replay.seed, replay.engine, replay.layout, replay.endgameThreshold);
+    game.setOutputLevel(FULL_OUTPUT);
+    game.showBoard();
+    while (!game.isP2Win() && game.getBoard(1).getNumShots() < 100) {
+        game.cpuShoot();
+        game.showBoard();
+    }
+}
+
+// Plays a saved game again and checks that every move matches.
+// Usage: replay replayFile [-n repeats] [-p]
+// Repeats time the game at full speed (no terminal I/O), -p shows the game being played.
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << "Usage: replay replayFile [-n repeats] [-p]" << endl;
+        return 1;
+    }
+    int repeats = 1;
+    bool isShown = false;
+    for (int i = 2; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "-n" && i + 1 < argc) {
+            repeats = stoi(argv[++i]);
+        } else if (arg == "-p") {
+            isShown = true;
+        }
+    }
+
+    Replay replay;
+    try {
+        replay = Replay::load(argv[1]);
+    } catch (runtime_error &e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Seed " << replay.seed << ", " << BattleshipCPU::getEngineName(replay.engine) << " engine, endgame threshold "
+         << replay.endgameThreshold << ", " << replay.moves.size() << " shots" << endl;
+
+    if (isShown) {
+        show(replay);
+    }
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < repeats; i++) {
+        int mismatch = replay.verify();
+        if (mismatch >= 0) {
+            cout << "Replay differs at move " << mismatch << endl;
+            return 1;
+        }
+    }
+    double micros = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+    cout << "Replay matches, " << micros / repeats << " us per game" << endl;
+    return 0;
+}
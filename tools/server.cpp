@@ -0,0 +1,75 @@
+#include "../include/gameServer.hpp"
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <string>
+using namespace std;
+
+// Hosts games over a local socket until interrupted (see GameSession for the protocol).
+// Usage: server [-p port] [-u socketPath] [-t numWorkers] [-m metricsFile]
+// Listens on 127.0.0.1:7070 by default, -u uses a Unix domain socket instead.
+// -m writes the metrics of every game in Prometheus text format when it stops (e.g. for a textfile collector).
+
+static GameServer* runningServer = nullptr;
+
+static void onSignal(int) {
+    if (runningServer) {
+        runningServer->stop();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int port = 7070;
+    string socketPath;
+    int numWorkers = 2;
+    string metricsFile;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "-p" && i + 1 < argc) {
+            port = stoi(argv[++i]);
+        } else if (arg == "-u" && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (arg == "-t" && i + 1 < argc) {
+            numWorkers = stoi(argv[++i]);
+        } else if (arg == "-m" && i + 1 < argc) {
+            metricsFile = argv[++i];
+        } else {
+            cout << "Usage: server [-p port] [-u socketPath] [-t numWorkers] [-m metricsFile]" << endl;
+            return 1;
+        }
+    }
+
+    try {
+        GameServer server(numWorkers);
+        if (socketPath.empty()) {
+            server.listenTcp(port);
+            cout << "Listening on 127.0.0.1:" << server.getPort();
+        } else {
+            server.listenUnix(socketPath);
+            cout << "Listening on " << socketPath;
+        }
+        cout << " with " << numWorkers << " workers" << endl;
+
+        runningServer = &server;
+        signal(SIGINT, onSignal);
+        signal(SIGTERM, onSignal);
+        server.run();
+        runningServer = nullptr;
+
+        cout << "Served " << server.getSessions() << " sessions, " << server.getRequests() << " requests" << endl;
+    } catch (runtime_error &e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+
+    // The server's games have all been destroyed now, so every game is in the process's metrics.
+    if (!metricsFile.empty()) {
+        ofstream metricsOut(metricsFile);
+        Metrics::writePrometheus(metricsOut, Metrics::getProcessMetrics(), "scope=\"process\"");
+        if (!metricsOut) {
+            cout << "Error: The metrics file '" << metricsFile << "' cannot be written." << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
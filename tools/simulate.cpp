@@ -0,0 +1,139 @@
+#include "../include/simulator.hpp"
+#include "../include/replay.hpp"
+#include "../include/boardCorpus.hpp"
+#include <sys/stat.h>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+using namespace std;
+
+// Headless simulations of the CPU against random fleets or board files.
+// Usage: simulate [numGames] [-t numThreads] [-e approximate|exact|sampling|random|checkerboard] [-g endgameThreshold] [-s seed] [-r replayFile] [-a archiveFile] [-c corpusPath] [-b boardFile]... [-m metricsFile] [-j gameMetricsFile]
+// Board files are read from the boards folder, like the game does.
+// -g solves the endgame exactly once at most that many fleets are left (see EndgameSolver, off by default).
+// The same seed plays the same games. -r saves a replay of the game that needed the most shots.
+// -a appends every game to a binary archive (see GameArchive).
+// -c loads every board from a directory, or a file of boards separated by blank lines (see BoardCorpus).
+// -m writes the metrics of the whole run (JSON if the name ends in .json, otherwise Prometheus text),
+// -j writes a line of JSON metrics per game (see Metrics).
+int main(int argc, char* argv[]) {
+    long long numGames = 10000;
+    int numThreads = thread::hardware_concurrency();
+    vector<string> boardFiles;
+    DensityEngine engine = APPROXIMATE_DENSITY;
+    int endgameThreshold = 0;
+    uint64_t seed = random_device()();
+    string replayFile;
+    string archiveFile;
+    vector<string> corpusPaths;
+    string metricsFile;
+    string gameMetricsFile;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "-t" && i + 1 < argc) {
+            numThreads = stoi(argv[++i]);
+        } else if (arg == "-e" && i + 1 < argc && BattleshipCPU::getEngine(argv[i + 1], engine)) {
+            i++;
+        } else if (arg == "-g" && i + 1 < argc) {
+            endgameThreshold = stoi(argv[++i]);
+        } else if (arg == "-s" && i + 1 < argc) {
+            seed = stoull(argv[++i]);
+        } else if (arg == "-r" && i + 1 < argc) {
+            replayFile = argv[++i];
+        } else if (arg == "-a" && i + 1 < argc) {
+            archiveFile = argv[++i];
+        } else if (arg == "-c" && i + 1 < argc) {
+            corpusPaths.push_back(argv[++i]);
+        } else if (arg == "-b" && i + 1 < argc) {
+            boardFiles.push_back(argv[++i]);
+        } else if (arg == "-m" && i + 1 < argc) {
+            metricsFile = argv[++i];
+        } else if (arg == "-j" && i + 1 < argc) {
+            gameMetricsFile = argv[++i];
+        } else if (arg[0] != '-') {
+            numGames = stoll(arg);
+        } else {
+            cout << "Usage: simulate [numGames] [-t numThreads] [-e approximate|exact|sampling|random|checkerboard] [-g endgameThreshold] [-s seed] [-r replayFile] [-a archiveFile] [-c corpusPath] [-b boardFile]... [-m metricsFile] [-j gameMetricsFile]" << endl;
+            return 1;
+        }
+    }
+
+    Simulator simulator(numThreads);
+    simulator.setDensityEngine(engine);
+    simulator.setEndgameThreshold(endgameThreshold);
+    simulator.setSeed(seed);
+    BoardCorpus corpus(numThreads);
+    for (string path : corpusPaths) {
+        struct stat buffer;
+        bool isDirectory = !stat(path.c_str(), &buffer) && S_ISDIR(buffer.st_mode);
+        if (isDirectory) {
+            corpus.loadDirectory(path);
+        } else {
+            corpus.loadFile(path);
+        }
+    }
+    for (const CorpusError &error : corpus.getErrors()) {
+        cout << "Skipped: " << BoardCorpus::getMessage(error) << endl;
+    }
+    for (int i = 0; i < corpus.size(); i++) {
+        simulator.addCorpusLayout(corpus.getLayout(i));
+    }
+
+    ArchiveWriter archive;
+    ofstream gameMetrics;
+    try {
+        for (string fileName : boardFiles) {
+            simulator.addCorpusBoard(fileName);
+        }
+        if (!archiveFile.empty()) {
+            archive.open(archiveFile);
+            simulator.setArchive(&archive);
+        }
+        if (!gameMetricsFile.empty()) {
+            gameMetrics.open(gameMetricsFile);
+            if (!gameMetrics.is_open()) {
+                throw runtime_error("The metrics file '" + gameMetricsFile + "' cannot be written.");
+            }
+            simulator.setMetricsLog(&gameMetrics);
+        }
+    } catch (runtime_error &e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+
+    SimulationResult result = simulator.run(numGames);
+    cout << "Seed: " << seed << endl;
+    Simulator::printReport(result, cout);
+
+    if (!metricsFile.empty()) {
+        ofstream metricsOut(metricsFile);
+        bool isJson = metricsFile.size() > 5 && metricsFile.substr(metricsFile.size() - 5) == ".json";
+        if (isJson) {
+            Metrics::writeJson(metricsOut, Metrics::getProcessMetrics());
+            metricsOut << endl;
+        } else {
+            Metrics::writePrometheus(metricsOut, Metrics::getProcessMetrics(), "scope=\"process\"");
+        }
+        if (!metricsOut) {
+            cout << "Error: The metrics file '" << metricsFile << "' cannot be written." << endl;
+            return 1;
+        }
+    }
+
+    if (!replayFile.empty() && result.worstGame >= 0) {
+        long long game = result.worstGame;
+        Replay replay = Replay::record(simulator.getGameSeed(game), engine, simulator.getGameLayout(game),
+                                       endgameThreshold);
+        try {
+            replay.save(replayFile);
+        } catch (runtime_error &e) {
+            cout << "Error: " << e.what() << endl;
+            return 1;
+        }
+        cout << "Saved game " << game << " (" << replay.moves.size() << " shots) to " << replayFile << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "../include/tournament.hpp"
+#include "../include/boardCorpus.hpp"
+#include <sys/stat.h>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+using namespace std;
+
+// Plays CPU configurations against the same fleets until their differences are settled.
+// Usage: tournament [-e engine[:endgameThreshold]]... [-t numThreads] [-s seed] [-n roundGames] [-m maxGames] [-a alpha] [-d margin] [-c corpusPath]... [-b boardFile]...
+// Without -e every engine plays. A threshold solves that engine's endgame (see EndgameSolver), so
+// -e approximate -e approximate:10 compares it off and on. Random fleets alternate with the corpus boards, if any are given.
+int main(int argc, char* argv[]) {
+    int numThreads = thread::hardware_concurrency();
+    vector<DensityEngine> engines;
+    vector<int> endgameThresholds;
+    uint64_t seed = random_device()();
+    long long roundGames = 200;
+    long long maxGames = 20000;
+    double alpha = 0.05;
+    double margin = 0.25;
+    vector<string> corpusPaths;
+    vector<string> boardFiles;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        DensityEngine engine;
+        string entry = (i + 1 < argc) ? argv[i + 1] : "";
+        size_t colon = entry.find(':');
+        if (arg == "-e" && i + 1 < argc && BattleshipCPU::getEngine(entry.substr(0, colon), engine)) {
+            engines.push_back(engine);
+            endgameThresholds.push_back((colon == string::npos) ? 0 : stoi(entry.substr(colon + 1)));
+            i++;
+        } else if (arg == "-t" && i + 1 < argc) {
+            numThreads = stoi(argv[++i]);
+        } else if (arg == "-s" && i + 1 < argc) {
+            seed = stoull(argv[++i]);
+        } else if (arg == "-n" && i + 1 < argc) {
+            roundGames = stoll(argv[++i]);
+        } else if (arg == "-m" && i + 1 < argc) {
+            maxGames = stoll(argv[++i]);
+        } else if (arg == "-a" && i + 1 < argc) {
+            alpha = stod(argv[++i]);
+        } else if (arg == "-d" && i + 1 < argc) {
+            margin = stod(argv[++i]);
+        } else if (arg == "-c" && i + 1 < argc) {
+            corpusPaths.push_back(argv[++i]);
+        } else if (arg == "-b" && i + 1 < argc) {
+            boardFiles.push_back(argv[++i]);
+        } else {
+            cout << "Usage: tournament [-e engine[:endgameThreshold]]... [-t numThreads] [-s seed] [-n roundGames] [-m maxGames] [-a alpha] [-d margin] [-c corpusPath]... [-b boardFile]..." << endl;
+            return 1;
+        }
+    }
+    if (engines.empty()) {
+        engines = {APPROXIMATE_DENSITY, EXACT_DENSITY, MONTE_CARLO_DENSITY, RANDOM_TARGETING, CHECKERBOARD_TARGETING};
+        endgameThresholds.assign(engines.size(), 0);
+    }
+
+    Tournament tournament(numThreads);
+    tournament.setSeed(seed);
+    tournament.setRoundGames(roundGames);
+    tournament.setMaxGames(maxGames);
+    tournament.setAlpha(alpha);
+    tournament.setMargin(margin);
+    for (int i = 0; i < int(engines.size()); i++) {
+        tournament.addEngine(engines[i], endgameThresholds[i]);
+    }
+
+    BoardCorpus corpus(numThreads);
+    for (string path : corpusPaths) {
+        struct stat buffer;
+        bool isDirectory = !stat(path.c_str(), &buffer) && S_ISDIR(buffer.st_mode);
+        if (isDirectory) {
+            corpus.loadDirectory(path);
+        } else {
+            corpus.loadFile(path);
+        }
+    }
+    for (const CorpusError &error : corpus.getErrors()) {
+        cout << "Skipped: " << BoardCorpus::getMessage(error) << endl;
+    }
+    for (int i = 0; i < corpus.size(); i++) {
+        tournament.addCorpusLayout(corpus.getLayout(i));
+    }
+    try {
+        for (string fileName : boardFiles) {
+            BattleshipCPU game;
+            game.setOutputLevel(QUIET_OUTPUT);
+            game.setBoardFile(1, fileName);
+            game.startGame(1, true, false);
+            tournament.addCorpusLayout(game.getBoardLayout(1));
+        }
+    } catch (runtime_error &e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+
+    cout << "Seed: " << seed << endl;
+    tournament.run(&cout);
+    tournament.printReport(cout);
+    return 0;
+}